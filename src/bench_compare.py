@@ -0,0 +1,69 @@
+#!/usr/bin/env python3
+"""Compares two Google Benchmark JSON reports and flags slowdowns.
+
+Usage: bench_compare.py BASELINE CURRENT [--threshold 0.10] [--metric cpu_time]
+
+Runs are matched by name. When a report holds repetition aggregates only the
+medians are compared. Exits with status 1 when any benchmark got slower than
+the baseline by more than the threshold, so it can gate CI.
+"""
+
+import argparse
+import json
+import sys
+
+TIME_UNITS = {"ns": 1e-9, "us": 1e-6, "ms": 1e-3, "s": 1.0}
+
+
+def load(path, metric):
+    with open(path) as report:
+        runs = json.load(report)["benchmarks"]
+    medians = [run for run in runs if run.get("aggregate_name") == "median"]
+    if medians:
+        runs = medians
+    times = {}
+    for run in runs:
+        if run.get("run_type", "iteration") == "aggregate" and not medians:
+            continue
+        name = run.get("run_name", run["name"])
+        times[name] = run[metric] * TIME_UNITS[run.get("time_unit", "ns")]
+    return times
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="allowed relative slowdown (default 0.10)")
+    parser.add_argument("--metric", choices=["cpu_time", "real_time"],
+                        default="cpu_time")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline, args.metric)
+    current = load(args.current, args.metric)
+    regressions = 0
+    width = max((len(name) for name in current), default=4)
+    print(f"{'name':<{width}}  {'baseline':>12}  {'current':>12}  change")
+    for name, seconds in current.items():
+        if name not in baseline:
+            print(f"{name:<{width}}  {'-':>12}  {seconds:>12.3e}  new")
+            continue
+        change = seconds / baseline[name] - 1
+        flag = ""
+        if change > args.threshold:
+            flag = "  SLOWER"
+            regressions += 1
+        print(f"{name:<{width}}  {baseline[name]:>12.3e}  {seconds:>12.3e}  "
+              f"{change:+7.1%}{flag}")
+    for name in baseline.keys() - current.keys():
+        print(f"{name:<{width}}  {baseline[name]:>12.3e}  {'-':>12}  removed")
+    if regressions:
+        print(f"{regressions} benchmark(s) slower than the baseline by more "
+              f"than {args.threshold:.0%}")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
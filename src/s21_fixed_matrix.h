@@ -0,0 +1,336 @@
+#ifndef SRC_S21_FIXED_MATRIX_H_
+#define SRC_S21_FIXED_MATRIX_H_
+
+#include <initializer_list>
+#include <stdexcept>
+
+#include "s21_matrix_oop.h"
+
+/*
+ * R x C matrix with inline storage and dimensions fixed at compile time.
+ * There is no allocation and no runtime size check: mismatched operands do
+ * not compile. Every operation is constexpr, and Determinant/InverseMatrix
+ * use closed forms for 2x2, 3x3 and 4x4.
+ */
+template <int R, int C>
+class S21FixedMatrix {
+  static_assert(R > 0 && C > 0, "Incorrect matrix size");
+
+ public:
+  constexpr S21FixedMatrix() : matrix_{} {}
+
+  // Fills the matrix row by row; missing trailing elements stay zero.
+  constexpr S21FixedMatrix(std::initializer_list<double> values) : matrix_{} {
+    if (values.size() > std::size_t(R) * C) {
+      throw std::out_of_range("Too many initializers");
+    }
+    int index = 0;
+    for (double value : values) {
+      matrix_[index / C][index % C] = value;
+      index++;
+    }
+  }
+
+  explicit S21FixedMatrix(const S21Matrix &other) : matrix_{} {
+    if (other.GetRows() != R || other.GetCols() != C) {
+      throw std::out_of_range(
+          "Incorrect input, matrices should have the same size");
+    }
+    for (int i = 0; i < R; i++) {
+      for (int j = 0; j < C; j++) matrix_[i][j] = other(i, j);
+    }
+  }
+
+  S21Matrix ToMatrix() const {
+    S21Matrix result(R, C);
+    for (int i = 0; i < R; i++) {
+      for (int j = 0; j < C; j++) result(i, j) = matrix_[i][j];
+    }
+    return result;
+  }
+
+  static constexpr int GetRows() { return R; }
+  static constexpr int GetCols() { return C; }
+
+  constexpr bool EqMatrix(const S21FixedMatrix &other) const {
+    for (int i = 0; i < R; i++) {
+      for (int j = 0; j < C; j++) {
+        double diff = matrix_[i][j] - other.matrix_[i][j];
+        if (diff > 1e-7 || diff < -1e-7) return false;
+      }
+    }
+    return true;
+  }
+
+  constexpr void SumMatrix(const S21FixedMatrix &other) {
+    for (int i = 0; i < R; i++) {
+      for (int j = 0; j < C; j++) matrix_[i][j] += other.matrix_[i][j];
+    }
+  }
+
+  constexpr void SubMatrix(const S21FixedMatrix &other) {
+    for (int i = 0; i < R; i++) {
+      for (int j = 0; j < C; j++) matrix_[i][j] -= other.matrix_[i][j];
+    }
+  }
+
+  constexpr void MulNumber(const double num) {
+    for (int i = 0; i < R; i++) {
+      for (int j = 0; j < C; j++) matrix_[i][j] *= num;
+    }
+  }
+
+  // The product has a different type unless both operands are square, so it
+  // is returned instead of replacing *this.
+  template <int K>
+  constexpr S21FixedMatrix<R, K> MulMatrix(
+      const S21FixedMatrix<C, K> &other) const {
+    S21FixedMatrix<R, K> result;
+    for (int i = 0; i < R; i++) {
+      for (int k = 0; k < C; k++) {
+        const double a = matrix_[i][k];
+        for (int j = 0; j < K; j++) result(i, j) += a * other(k, j);
+      }
+    }
+    return result;
+  }
+
+  constexpr S21FixedMatrix<C, R> Transpose() const {
+    S21FixedMatrix<C, R> result;
+    for (int i = 0; i < R; i++) {
+      for (int j = 0; j < C; j++) result(j, i) = matrix_[i][j];
+    }
+    return result;
+  }
+
+  constexpr double Determinant() const {
+    static_assert(R == C, "rows and cols aren't equal");
+    const auto &a = matrix_;
+    if constexpr (R == 1) {
+      return a[0][0];
+    } else if constexpr (R == 2) {
+      return a[0][0] * a[1][1] - a[0][1] * a[1][0];
+    } else if constexpr (R == 3) {
+      return a[0][0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1]) -
+             a[0][1] * (a[1][0] * a[2][2] - a[1][2] * a[2][0]) +
+             a[0][2] * (a[1][0] * a[2][1] - a[1][1] * a[2][0]);
+    } else if constexpr (R == 4) {
+      const Minors4 m(a);
+      return m.s[0] * m.c[5] - m.s[1] * m.c[4] + m.s[2] * m.c[3] +
+             m.s[3] * m.c[2] - m.s[4] * m.c[1] + m.s[5] * m.c[0];
+    } else {
+      S21FixedMatrix lu(*this);
+      double determ = 1;
+      for (int k = 0; k < R; k++) {
+        int p = lu.pivot_row(k);
+        if (lu.matrix_[p][k] == 0) return 0;
+        if (p != k) {
+          lu.swap_rows(p, k);
+          determ = -determ;
+        }
+        determ *= lu.matrix_[k][k];
+        lu.eliminate_below(k);
+      }
+      return determ;
+    }
+  }
+
+  constexpr S21FixedMatrix InverseMatrix() const {
+    static_assert(R == C, "rows and cols aren't equal");
+    const auto &a = matrix_;
+    S21FixedMatrix result;
+    auto &r = result.matrix_;
+    if constexpr (R <= 4) {
+      const double det = Determinant();
+      if (det == 0) throw std::out_of_range("Determinant must not be zero");
+      const double inv = 1.0 / det;
+      if constexpr (R == 1) {
+        r[0][0] = inv;
+      } else if constexpr (R == 2) {
+        r[0][0] = a[1][1] * inv;
+        r[0][1] = -a[0][1] * inv;
+        r[1][0] = -a[1][0] * inv;
+        r[1][1] = a[0][0] * inv;
+      } else if constexpr (R == 3) {
+        r[0][0] = (a[1][1] * a[2][2] - a[1][2] * a[2][1]) * inv;
+        r[0][1] = (a[0][2] * a[2][1] - a[0][1] * a[2][2]) * inv;
+        r[0][2] = (a[0][1] * a[1][2] - a[0][2] * a[1][1]) * inv;
+        r[1][0] = (a[1][2] * a[2][0] - a[1][0] * a[2][2]) * inv;
+        r[1][1] = (a[0][0] * a[2][2] - a[0][2] * a[2][0]) * inv;
+        r[1][2] = (a[0][2] * a[1][0] - a[0][0] * a[1][2]) * inv;
+        r[2][0] = (a[1][0] * a[2][1] - a[1][1] * a[2][0]) * inv;
+        r[2][1] = (a[0][1] * a[2][0] - a[0][0] * a[2][1]) * inv;
+        r[2][2] = (a[0][0] * a[1][1] - a[0][1] * a[1][0]) * inv;
+      } else {
+        const Minors4 m(a);
+        const double *s = m.s;
+        const double *c = m.c;
+        r[0][0] = (a[1][1] * c[5] - a[1][2] * c[4] + a[1][3] * c[3]) * inv;
+        r[0][1] = (-a[0][1] * c[5] + a[0][2] * c[4] - a[0][3] * c[3]) * inv;
+        r[0][2] = (a[3][1] * s[5] - a[3][2] * s[4] + a[3][3] * s[3]) * inv;
+        r[0][3] = (-a[2][1] * s[5] + a[2][2] * s[4] - a[2][3] * s[3]) * inv;
+        r[1][0] = (-a[1][0] * c[5] + a[1][2] * c[2] - a[1][3] * c[1]) * inv;
+        r[1][1] = (a[0][0] * c[5] - a[0][2] * c[2] + a[0][3] * c[1]) * inv;
+        r[1][2] = (-a[3][0] * s[5] + a[3][2] * s[2] - a[3][3] * s[1]) * inv;
+        r[1][3] = (a[2][0] * s[5] - a[2][2] * s[2] + a[2][3] * s[1]) * inv;
+        r[2][0] = (a[1][0] * c[4] - a[1][1] * c[2] + a[1][3] * c[0]) * inv;
+        r[2][1] = (-a[0][0] * c[4] + a[0][1] * c[2] - a[0][3] * c[0]) * inv;
+        r[2][2] = (a[3][0] * s[4] - a[3][1] * s[2] + a[3][3] * s[0]) * inv;
+        r[2][3] = (-a[2][0] * s[4] + a[2][1] * s[2] - a[2][3] * s[0]) * inv;
+        r[3][0] = (-a[1][0] * c[3] + a[1][1] * c[1] - a[1][2] * c[0]) * inv;
+        r[3][1] = (a[0][0] * c[3] - a[0][1] * c[1] + a[0][2] * c[0]) * inv;
+        r[3][2] = (-a[3][0] * s[3] + a[3][1] * s[1] - a[3][2] * s[0]) * inv;
+        r[3][3] = (a[2][0] * s[3] - a[2][1] * s[1] + a[2][2] * s[0]) * inv;
+      }
+    } else {
+      // Gauss-Jordan with partial pivoting on [A | I].
+      S21FixedMatrix work(*this);
+      for (int i = 0; i < R; i++) r[i][i] = 1;
+      for (int k = 0; k < R; k++) {
+        int p = work.pivot_row(k);
+        if (work.matrix_[p][k] == 0) {
+          throw std::out_of_range("Determinant must not be zero");
+        }
+        work.swap_rows(p, k);
+        result.swap_rows(p, k);
+        const double inv = 1.0 / work.matrix_[k][k];
+        for (int j = 0; j < R; j++) {
+          work.matrix_[k][j] *= inv;
+          r[k][j] *= inv;
+        }
+        for (int i = 0; i < R; i++) {
+          const double l = work.matrix_[i][k];
+          if (i == k || l == 0) continue;
+          for (int j = 0; j < R; j++) {
+            work.matrix_[i][j] -= l * work.matrix_[k][j];
+            r[i][j] -= l * r[k][j];
+          }
+        }
+      }
+    }
+    return result;
+  }
+
+  constexpr S21FixedMatrix operator+(const S21FixedMatrix &other) const {
+    S21FixedMatrix result(*this);
+    result.SumMatrix(other);
+    return result;
+  }
+
+  constexpr S21FixedMatrix operator-(const S21FixedMatrix &other) const {
+    S21FixedMatrix result(*this);
+    result.SubMatrix(other);
+    return result;
+  }
+
+  template <int K>
+  constexpr S21FixedMatrix<R, K> operator*(
+      const S21FixedMatrix<C, K> &other) const {
+    return MulMatrix(other);
+  }
+
+  constexpr S21FixedMatrix operator*(const double &num) const {
+    S21FixedMatrix result(*this);
+    result.MulNumber(num);
+    return result;
+  }
+
+  constexpr bool operator==(const S21FixedMatrix &other) const {
+    return EqMatrix(other);
+  }
+
+  constexpr S21FixedMatrix &operator+=(const S21FixedMatrix &other) {
+    SumMatrix(other);
+    return *this;
+  }
+
+  constexpr S21FixedMatrix &operator-=(const S21FixedMatrix &other) {
+    SubMatrix(other);
+    return *this;
+  }
+
+  constexpr S21FixedMatrix &operator*=(const S21FixedMatrix<C, C> &other) {
+    *this = MulMatrix(other);
+    return *this;
+  }
+
+  constexpr S21FixedMatrix &operator*=(const double &num) {
+    MulNumber(num);
+    return *this;
+  }
+
+  constexpr double &operator()(const int row, const int col) {
+    check_index(row, col);
+    return matrix_[row][col];
+  }
+
+  constexpr const double &operator()(const int row, const int col) const {
+    check_index(row, col);
+    return matrix_[row][col];
+  }
+
+ private:
+  double matrix_[R][C];
+
+  // The 2x2 minors of the top two rows (s) and the bottom two rows (c) that
+  // the 4x4 determinant and inverse are expanded over.
+  struct Minors4 {
+    double s[6], c[6];
+    constexpr explicit Minors4(const double (&a)[R][C]) : s{}, c{} {
+      s[0] = a[0][0] * a[1][1] - a[1][0] * a[0][1];
+      s[1] = a[0][0] * a[1][2] - a[1][0] * a[0][2];
+      s[2] = a[0][0] * a[1][3] - a[1][0] * a[0][3];
+      s[3] = a[0][1] * a[1][2] - a[1][1] * a[0][2];
+      s[4] = a[0][1] * a[1][3] - a[1][1] * a[0][3];
+      s[5] = a[0][2] * a[1][3] - a[1][2] * a[0][3];
+      c[0] = a[2][0] * a[3][1] - a[3][0] * a[2][1];
+      c[1] = a[2][0] * a[3][2] - a[3][0] * a[2][2];
+      c[2] = a[2][0] * a[3][3] - a[3][0] * a[2][3];
+      c[3] = a[2][1] * a[3][2] - a[3][1] * a[2][2];
+      c[4] = a[2][1] * a[3][3] - a[3][1] * a[2][3];
+      c[5] = a[2][2] * a[3][3] - a[3][2] * a[2][3];
+    }
+  };
+
+  static constexpr void check_index(int row, int col) {
+    if (R <= row || C <= col || row < 0 || col < 0) {
+      throw std::out_of_range("Incorrect Index");
+    }
+  }
+
+  constexpr int pivot_row(int k) const {
+    int p = k;
+    double max = matrix_[k][k] < 0 ? -matrix_[k][k] : matrix_[k][k];
+    for (int i = k + 1; i < R; i++) {
+      double v = matrix_[i][k] < 0 ? -matrix_[i][k] : matrix_[i][k];
+      if (v > max) {
+        max = v;
+        p = i;
+      }
+    }
+    return p;
+  }
+
+  constexpr void swap_rows(int p, int k) {
+    for (int j = 0; j < C; j++) {
+      double tmp = matrix_[p][j];
+      matrix_[p][j] = matrix_[k][j];
+      matrix_[k][j] = tmp;
+    }
+  }
+
+  constexpr void eliminate_below(int k) {
+    for (int i = k + 1; i < R; i++) {
+      const double l = matrix_[i][k] / matrix_[k][k];
+      for (int j = k; j < C; j++) matrix_[i][j] -= l * matrix_[k][j];
+    }
+  }
+};
+
+template <int R, int C>
+constexpr S21FixedMatrix<R, C> operator*(const double &num,
+                                         const S21FixedMatrix<R, C> &matrix) {
+  return matrix * num;
+}
+
+#endif  // SRC_S21_FIXED_MATRIX_H_
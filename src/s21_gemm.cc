@@ -0,0 +1,281 @@
+#include "s21_gemm.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include "s21_thread_pool.h"
+
+namespace s21 {
+
+namespace {
+
+std::atomic<int> block_mc{128};
+std::atomic<int> block_kc{256};
+std::atomic<int> block_nc{4096};
+
+// Below this many multiply-adds packing costs more than it saves.
+constexpr long kSmallGemm = 32 * 32 * 32;
+// Below this many multiply-adds waking the thread pool costs more than it
+// saves.
+constexpr long kParallelGemm = 128 * 128 * 128;
+// Smallest edge of an output tile handed to one thread.
+constexpr int kMinTile = 64;
+// GEMV streams A once, so it pays off to wake the pool much earlier.
+constexpr long kParallelGemv = 256 * 256;
+// Rows of y per GEMV task.
+constexpr int kGemvRows = 256;
+
+int RoundUp(int value, int step) { return (value + step - 1) / step * step; }
+
+template <typename T>
+void ScaleC(int m, int n, T beta, T *c, std::ptrdiff_t ldc) {
+  if (beta == 1) return;
+  for (int i = 0; i < m; i++) {
+    T *ci = c + i * ldc;
+    if (beta == 0) {
+      std::fill_n(ci, n, T(0));
+    } else {
+      for (int j = 0; j < n; j++) ci[j] *= beta;
+    }
+  }
+}
+
+template <typename T>
+void SmallGemm(int m, int n, int k, T alpha, const T *a, std::ptrdiff_t rsa,
+               std::ptrdiff_t csa, const T *b, std::ptrdiff_t rsb,
+               std::ptrdiff_t csb, T *c, std::ptrdiff_t ldc) {
+  for (int i = 0; i < m; i++) {
+    T *ci = c + i * ldc;
+    for (int p = 0; p < k; p++) {
+      const T aip = alpha * a[i * rsa + p * csa];
+      const T *bp = b + p * rsb;
+      for (int j = 0; j < n; j++) ci[j] += aip * bp[j * csb];
+    }
+  }
+}
+
+// Packs an mc x kc block of A into kGemmMr-row slivers, zero padded.
+template <typename T>
+void PackA(int mc, int kc, const T *a, std::ptrdiff_t rsa, std::ptrdiff_t csa,
+           T *packed) {
+  for (int ir = 0; ir < mc; ir += kGemmMr) {
+    const int mr = std::min(kGemmMr, mc - ir);
+    for (int p = 0; p < kc; p++) {
+      const T *ap = a + ir * rsa + p * csa;
+      int i = 0;
+      for (; i < mr; i++) *packed++ = ap[i * rsa];
+      for (; i < kGemmMr; i++) *packed++ = 0;
+    }
+  }
+}
+
+// Packs a kc x nc panel of B into kGemmNr-column slivers, zero padded.
+template <typename T>
+void PackB(int kc, int nc, const T *b, std::ptrdiff_t rsb, std::ptrdiff_t csb,
+           T *packed) {
+  for (int jr = 0; jr < nc; jr += kGemmNr) {
+    const int nr = std::min(kGemmNr, nc - jr);
+    for (int p = 0; p < kc; p++) {
+      const T *bp = b + p * rsb + jr * csb;
+      int j = 0;
+      for (; j < nr; j++) *packed++ = bp[j * csb];
+      for (; j < kGemmNr; j++) *packed++ = 0;
+    }
+  }
+}
+
+// ab = sum over p of the outer products of one A sliver and one B sliver.
+template <typename T>
+void MicroKernel(int kc, const T *ap, const T *bp, T ab[kGemmMr][kGemmNr]) {
+  T acc[kGemmMr][kGemmNr] = {};
+  for (int p = 0; p < kc; p++) {
+    for (int i = 0; i < kGemmMr; i++) {
+      const T ai = ap[i];
+      for (int j = 0; j < kGemmNr; j++) acc[i][j] += ai * bp[j];
+    }
+    ap += kGemmMr;
+    bp += kGemmNr;
+  }
+  for (int i = 0; i < kGemmMr; i++) {
+    for (int j = 0; j < kGemmNr; j++) ab[i][j] = acc[i][j];
+  }
+}
+
+template <typename T>
+void MacroKernel(int mc, int nc, int kc, T alpha, const T *packed_a,
+                 const T *packed_b, T beta, T *c, std::ptrdiff_t ldc) {
+  T ab[kGemmMr][kGemmNr];
+  for (int jr = 0; jr < nc; jr += kGemmNr) {
+    const int nr = std::min(kGemmNr, nc - jr);
+    for (int ir = 0; ir < mc; ir += kGemmMr) {
+      const int mr = std::min(kGemmMr, mc - ir);
+      MicroKernel(kc, packed_a + ir * kc, packed_b + jr * kc, ab);
+      T *cij = c + ir * ldc + jr;
+      for (int i = 0; i < mr; i++) {
+        for (int j = 0; j < nr; j++) {
+          T &value = cij[i * ldc + j];
+          value = alpha * ab[i][j] + (beta == 0 ? 0 : beta * value);
+        }
+      }
+    }
+  }
+}
+
+template <typename T>
+void BlockedGemm(int m, int n, int k, T alpha, const T *a, std::ptrdiff_t rsa,
+                 std::ptrdiff_t csa, const T *b, std::ptrdiff_t rsb,
+                 std::ptrdiff_t csb, T beta, T *c, std::ptrdiff_t ldc) {
+  const GemmBlocking blocking = GetGemmBlocking();
+  const int mc_max = std::min(blocking.mc, RoundUp(m, kGemmMr));
+  const int kc_max = std::min(blocking.kc, k);
+  const int nc_max = std::min(blocking.nc, RoundUp(n, kGemmNr));
+  std::vector<T> packed_a(std::size_t(mc_max) * kc_max);
+  std::vector<T> packed_b(std::size_t(kc_max) * nc_max);
+  for (int jc = 0; jc < n; jc += nc_max) {
+    const int nc = std::min(nc_max, n - jc);
+    for (int pc = 0; pc < k; pc += kc_max) {
+      const int kc = std::min(kc_max, k - pc);
+      const T beta_pc = pc == 0 ? beta : T(1);
+      PackB(kc, nc, b + pc * rsb + jc * csb, rsb, csb, packed_b.data());
+      for (int ic = 0; ic < m; ic += mc_max) {
+        const int mc = std::min(mc_max, m - ic);
+        PackA(mc, kc, a + ic * rsa + pc * csa, rsa, csa, packed_a.data());
+        MacroKernel(mc, nc, kc, alpha, packed_a.data(), packed_b.data(),
+                    beta_pc, c + ic * ldc + jc, ldc);
+      }
+    }
+  }
+}
+
+/*
+ * y = alpha * A * x + beta * y for an m x k operand A, every operand strided.
+ * Rows of A that are contiguous are reduced by dot products; otherwise the
+ * columns of A are added up into a local accumulator so that A is still
+ * read along its contiguous direction. Blocks of kGemvRows rows of y go to
+ * the pool when A is large.
+ */
+template <typename T>
+void Gemv(int m, int k, T alpha, const T *a, std::ptrdiff_t rsa,
+          std::ptrdiff_t csa, const T *x, std::ptrdiff_t incx, T beta, T *y,
+          std::ptrdiff_t incy) {
+  auto rows = [&](int i0, int i1) {
+    std::vector<T> acc(i1 - i0, T(0));
+    if (csa == 1) {
+      for (int i = i0; i < i1; i++) {
+        const T *ai = a + i * rsa;
+        T sum = 0;
+        for (int p = 0; p < k; p++) sum += ai[p] * x[p * incx];
+        acc[i - i0] = sum;
+      }
+    } else {
+      for (int p = 0; p < k; p++) {
+        const T xp = x[p * incx];
+        const T *ap = a + p * csa;
+        for (int i = i0; i < i1; i++) acc[i - i0] += ap[i * rsa] * xp;
+      }
+    }
+    for (int i = i0; i < i1; i++) {
+      T &value = y[i * incy];
+      value = alpha * acc[i - i0] + (beta == 0 ? 0 : beta * value);
+    }
+  };
+  const int blocks = (m + kGemvRows - 1) / kGemvRows;
+  if (blocks > 1 && long(m) * k >= kParallelGemv &&
+      ThreadPool::Instance().ThreadCount() > 1) {
+    ThreadPool::Instance().ParallelFor(blocks, [&](int block) {
+      const int i0 = block * kGemvRows;
+      rows(i0, std::min(i0 + kGemvRows, m));
+    });
+  } else {
+    rows(0, m);
+  }
+}
+
+// Splits C into a grid of output tiles, each computed by one pool task over
+// the full depth k, so tiles never share output and need no reduction.
+template <typename T>
+void ParallelGemm(int threads, int m, int n, int k, T alpha, const T *a,
+                  std::ptrdiff_t rsa, std::ptrdiff_t csa, const T *b,
+                  std::ptrdiff_t rsb, std::ptrdiff_t csb, T beta, T *c,
+                  std::ptrdiff_t ldc) {
+  int tile_m = RoundUp(std::max(m / 2, kMinTile), kGemmMr);
+  int tile_n = RoundUp(std::max(n / 2, kMinTile), kGemmNr);
+  auto tiles = [&] {
+    return ((m + tile_m - 1) / tile_m) * ((n + tile_n - 1) / tile_n);
+  };
+  while (tiles() < 2 * threads && (tile_m > kMinTile || tile_n > kMinTile)) {
+    if (tile_m >= tile_n) {
+      tile_m = RoundUp(std::max(tile_m / 2, kMinTile), kGemmMr);
+    } else {
+      tile_n = RoundUp(std::max(tile_n / 2, kMinTile), kGemmNr);
+    }
+  }
+  const int grid_n = (n + tile_n - 1) / tile_n;
+  ThreadPool::Instance().ParallelFor(tiles(), [&](int tile) {
+    const int i0 = tile / grid_n * tile_m;
+    const int j0 = tile % grid_n * tile_n;
+    BlockedGemm(std::min(tile_m, m - i0), std::min(tile_n, n - j0), k, alpha,
+                a + i0 * rsa, rsa, csa, b + j0 * csb, rsb, csb, beta,
+                c + i0 * ldc + j0, ldc);
+  });
+}
+
+}  // namespace
+
+GemmBlocking GetGemmBlocking() {
+  return {block_mc.load(), block_kc.load(), block_nc.load()};
+}
+
+void SetGemmBlocking(const GemmBlocking &blocking) {
+  block_mc = RoundUp(std::max(blocking.mc, 1), kGemmMr);
+  block_kc = std::max(blocking.kc, 1);
+  block_nc = RoundUp(std::max(blocking.nc, 1), kGemmNr);
+}
+
+template <typename T>
+void Gemm(int m, int n, int k, T alpha, const T *a, std::ptrdiff_t rsa,
+          std::ptrdiff_t csa, const T *b, std::ptrdiff_t rsb,
+          std::ptrdiff_t csb, T beta, T *c, std::ptrdiff_t ldc) {
+  if (m <= 0 || n <= 0) return;
+  if (k <= 0 || alpha == 0) {
+    ScaleC(m, n, beta, c, ldc);
+    return;
+  }
+  if (n == 1) {
+    Gemv(m, k, alpha, a, rsa, csa, b, rsb, beta, c, ldc);
+    return;
+  }
+  if (m == 1) {
+    // c^T = alpha * B^T * a^T + beta * c^T.
+    Gemv(n, k, alpha, b, csb, rsb, a, csa, beta, c, std::ptrdiff_t(1));
+    return;
+  }
+  if (long(m) * n * k <= kSmallGemm) {
+    ScaleC(m, n, beta, c, ldc);
+    SmallGemm(m, n, k, alpha, a, rsa, csa, b, rsb, csb, c, ldc);
+    return;
+  }
+  const int threads = ThreadPool::Instance().ThreadCount();
+  if (threads > 1 && long(m) * n * k >= kParallelGemm) {
+    ParallelGemm(threads, m, n, k, alpha, a, rsa, csa, b, rsb, csb, beta, c,
+                 ldc);
+  } else {
+    BlockedGemm(m, n, k, alpha, a, rsa, csa, b, rsb, csb, beta, c, ldc);
+  }
+}
+
+template void Gemm(int m, int n, int k, float alpha, const float *a,
+                   std::ptrdiff_t rsa, std::ptrdiff_t csa, const float *b,
+                   std::ptrdiff_t rsb, std::ptrdiff_t csb, float beta, float *c,
+                   std::ptrdiff_t ldc);
+template void Gemm(int m, int n, int k, double alpha, const double *a,
+                   std::ptrdiff_t rsa, std::ptrdiff_t csa, const double *b,
+                   std::ptrdiff_t rsb, std::ptrdiff_t csb, double beta,
+                   double *c, std::ptrdiff_t ldc);
+template void Gemm(int m, int n, int k, long double alpha, const long double *a,
+                   std::ptrdiff_t rsa, std::ptrdiff_t csa, const long double *b,
+                   std::ptrdiff_t rsb, std::ptrdiff_t csb, long double beta,
+                   long double *c, std::ptrdiff_t ldc);
+
+}  // namespace s21
@@ -0,0 +1,38 @@
+#ifndef SRC_S21_GEMM_H_
+#define SRC_S21_GEMM_H_
+
+#include <cstddef>
+
+namespace s21 {
+
+/*
+ * Cache blocking of the packed GEMM. kc columns of an mc x kc block of A stay
+ * in L2, a kc x nc panel of B stays in L3, and one kc x kNr sliver of B is
+ * streamed through L1 by the micro-kernel.
+ */
+struct GemmBlocking {
+  int mc, kc, nc;
+};
+
+constexpr int kGemmMr = 4;
+constexpr int kGemmNr = 8;
+
+GemmBlocking GetGemmBlocking();
+void SetGemmBlocking(const GemmBlocking &blocking);
+
+/*
+ * C = alpha * A * B + beta * C for an m x k operand A and a k x n operand B.
+ * Both inputs are addressed through a row and a column stride, so transposed
+ * and strided operands need no copy. C is row-major with leading dimension
+ * ldc. When beta is zero C is overwritten and never read. Shapes with a
+ * single row or column of C take a GEMV kernel instead of packing.
+ * Instantiated for float, double and long double.
+ */
+template <typename T>
+void Gemm(int m, int n, int k, T alpha, const T *a, std::ptrdiff_t rsa,
+          std::ptrdiff_t csa, const T *b, std::ptrdiff_t rsb,
+          std::ptrdiff_t csb, T beta, T *c, std::ptrdiff_t ldc);
+
+}  // namespace s21
+
+#endif  // SRC_S21_GEMM_H_
@@ -0,0 +1,198 @@
+#include "s21_instrument.h"
+
+#include <atomic>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace s21 {
+
+namespace {
+
+constexpr int kOps = int(MatrixOp::kCount);
+
+constexpr const char *kOpNames[kOps] = {
+    "copy",      "eq_matrix", "sum_matrix",  "sub_matrix", "mul_number",
+    "mul_matrix", "transpose", "determinant", "inverse",    "complements",
+    "solve"};
+
+// Written only by the owning thread, read by any; relaxed atomics make the
+// cross-thread reads well defined without a locked instruction per bump.
+struct ThreadCounters {
+  std::atomic<std::uint64_t> calls[kOps] = {};
+  std::atomic<std::uint64_t> flops[kOps] = {};
+  std::atomic<std::uint64_t> nanoseconds[kOps] = {};
+  std::atomic<std::uint64_t> allocations{0};
+  std::atomic<std::uint64_t> bytes_allocated{0};
+  std::atomic<std::uint64_t> frees{0};
+  std::atomic<std::uint64_t> bytes_freed{0};
+  std::atomic<std::uint64_t> elements_copied{0};
+};
+
+void Bump(std::atomic<std::uint64_t> &counter, std::uint64_t value) {
+  counter.store(counter.load(std::memory_order_relaxed) + value,
+                std::memory_order_relaxed);
+}
+
+void Add(CounterSnapshot &sum, const ThreadCounters &counters) {
+  for (int op = 0; op < kOps; op++) {
+    sum.ops[op].calls += counters.calls[op].load(std::memory_order_relaxed);
+    sum.ops[op].flops += counters.flops[op].load(std::memory_order_relaxed);
+    sum.ops[op].nanoseconds +=
+        counters.nanoseconds[op].load(std::memory_order_relaxed);
+  }
+  sum.allocations += counters.allocations.load(std::memory_order_relaxed);
+  sum.bytes_allocated +=
+      counters.bytes_allocated.load(std::memory_order_relaxed);
+  sum.frees += counters.frees.load(std::memory_order_relaxed);
+  sum.bytes_freed += counters.bytes_freed.load(std::memory_order_relaxed);
+  sum.elements_copied +=
+      counters.elements_copied.load(std::memory_order_relaxed);
+}
+
+void Clear(ThreadCounters &counters) {
+  for (int op = 0; op < kOps; op++) {
+    counters.calls[op] = 0;
+    counters.flops[op] = 0;
+    counters.nanoseconds[op] = 0;
+  }
+  counters.allocations = 0;
+  counters.bytes_allocated = 0;
+  counters.frees = 0;
+  counters.bytes_freed = 0;
+  counters.elements_copied = 0;
+}
+
+struct Registry {
+  std::mutex mutex;
+  std::vector<ThreadCounters *> live;
+  CounterSnapshot retired = {};
+};
+
+// Never destroyed: pool workers may exit after static destructors have run.
+Registry &GetRegistry() {
+  static Registry *registry = new Registry;
+  return *registry;
+}
+
+struct Registration {
+  ThreadCounters counters;
+  Registration() {
+    Registry &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.live.push_back(&counters);
+  }
+  ~Registration() {
+    Registry &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    Add(registry.retired, counters);
+    for (ThreadCounters *&entry : registry.live) {
+      if (entry == &counters) {
+        entry = registry.live.back();
+        registry.live.pop_back();
+        break;
+      }
+    }
+  }
+};
+
+ThreadCounters &Local() {
+  thread_local Registration registration;
+  return registration.counters;
+}
+
+}  // namespace
+
+const char *OpName(MatrixOp op) { return kOpNames[int(op)]; }
+
+CounterSnapshot ReadCounters() {
+  Registry &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  CounterSnapshot sum = registry.retired;
+  for (const ThreadCounters *counters : registry.live) Add(sum, *counters);
+  return sum;
+}
+
+void ResetCounters() {
+  Registry &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.retired = {};
+  for (ThreadCounters *counters : registry.live) Clear(*counters);
+}
+
+std::string CountersToJson(const CounterSnapshot &snapshot) {
+  std::ostringstream out;
+  out << "{\"ops\": {";
+  for (int op = 0; op < kOps; op++) {
+    const OpCounters &counters = snapshot.ops[op];
+    out << (op == 0 ? "" : ", ") << '"' << kOpNames[op] << "\": {\"calls\": "
+        << counters.calls << ", \"flops\": " << counters.flops
+        << ", \"nanoseconds\": " << counters.nanoseconds << '}';
+  }
+  out << "}, \"allocations\": " << snapshot.allocations
+      << ", \"bytes_allocated\": " << snapshot.bytes_allocated
+      << ", \"frees\": " << snapshot.frees
+      << ", \"bytes_freed\": " << snapshot.bytes_freed
+      << ", \"elements_copied\": " << snapshot.elements_copied << '}';
+  return out.str();
+}
+
+std::string CountersToPrometheus(const CounterSnapshot &snapshot) {
+  std::ostringstream out;
+  auto family = [&](const char *name, const char *help) {
+    out << "# HELP s21_matrix_" << name << ' ' << help << "\n# TYPE s21_matrix_"
+        << name << " counter\n";
+  };
+  auto per_op = [&](const char *name, const char *help, auto field) {
+    family(name, help);
+    for (int op = 0; op < kOps; op++) {
+      out << "s21_matrix_" << name << "{op=\"" << kOpNames[op] << "\"} "
+          << field(snapshot.ops[op]) << '\n';
+    }
+  };
+  auto total = [&](const char *name, const char *help, std::uint64_t value) {
+    family(name, help);
+    out << "s21_matrix_" << name << ' ' << value << '\n';
+  };
+  per_op("op_calls_total", "Calls per operation.",
+         [](const OpCounters &op) { return op.calls; });
+  per_op("op_flops_total", "Estimated floating-point operations.",
+         [](const OpCounters &op) { return op.flops; });
+  per_op("op_seconds_total", "Wall time spent per operation.",
+         [](const OpCounters &op) { return op.nanoseconds * 1e-9; });
+  total("allocations_total", "Element buffers allocated.",
+        snapshot.allocations);
+  total("allocated_bytes_total", "Bytes of element buffers allocated.",
+        snapshot.bytes_allocated);
+  total("frees_total", "Element buffers freed.", snapshot.frees);
+  total("freed_bytes_total", "Bytes of element buffers freed.",
+        snapshot.bytes_freed);
+  total("copied_elements_total", "Elements copied between matrices.",
+        snapshot.elements_copied);
+  return out.str();
+}
+
+void CountOp(MatrixOp op, std::uint64_t flops, std::uint64_t nanoseconds) {
+  ThreadCounters &counters = Local();
+  Bump(counters.calls[int(op)], 1);
+  Bump(counters.flops[int(op)], flops);
+  Bump(counters.nanoseconds[int(op)], nanoseconds);
+}
+
+void CountAllocation(std::uint64_t bytes) {
+  ThreadCounters &counters = Local();
+  Bump(counters.allocations, 1);
+  Bump(counters.bytes_allocated, bytes);
+}
+
+void CountFree(std::uint64_t bytes) {
+  ThreadCounters &counters = Local();
+  Bump(counters.frees, 1);
+  Bump(counters.bytes_freed, bytes);
+}
+
+void CountCopy(std::uint64_t elements) {
+  Bump(Local().elements_copied, elements);
+}
+
+}  // namespace s21
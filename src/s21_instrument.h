@@ -0,0 +1,106 @@
+#ifndef SRC_S21_INSTRUMENT_H_
+#define SRC_S21_INSTRUMENT_H_
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace s21 {
+
+/*
+ * Counters for the S21Matrix hot paths, compiled in only when the library is
+ * built with -DS21_MATRIX_INSTRUMENT (make test_instrumented). Without it the
+ * S21_INSTRUMENT_* macros expand to nothing, their arguments are never
+ * evaluated and ReadCounters() returns zeros.
+ *
+ * Every thread bumps its own block of counters without read-modify-write
+ * instructions; ReadCounters() sums the blocks of live threads and of
+ * threads that have exited.
+ */
+#ifdef S21_MATRIX_INSTRUMENT
+constexpr bool kCountersEnabled = true;
+#else
+constexpr bool kCountersEnabled = false;
+#endif
+
+enum class MatrixOp {
+  kCopy,
+  kEq,
+  kSum,
+  kSub,
+  kMulNumber,
+  kMulMatrix,
+  kTranspose,
+  kDeterminant,
+  kInverse,
+  kComplements,
+  kSolve,
+  kCount
+};
+
+struct OpCounters {
+  std::uint64_t calls;
+  std::uint64_t flops;
+  std::uint64_t nanoseconds;
+};
+
+struct CounterSnapshot {
+  OpCounters ops[int(MatrixOp::kCount)];
+  std::uint64_t allocations;
+  std::uint64_t bytes_allocated;
+  std::uint64_t frees;
+  std::uint64_t bytes_freed;
+  std::uint64_t elements_copied;
+};
+
+// snake_case name of op, as used in both dumps.
+const char *OpName(MatrixOp op);
+
+CounterSnapshot ReadCounters();
+// Increments racing with a reset from another thread may be lost.
+void ResetCounters();
+std::string CountersToJson(const CounterSnapshot &snapshot);
+// Prometheus text exposition format, one counter family per field.
+std::string CountersToPrometheus(const CounterSnapshot &snapshot);
+
+void CountOp(MatrixOp op, std::uint64_t flops, std::uint64_t nanoseconds);
+void CountAllocation(std::uint64_t bytes);
+void CountFree(std::uint64_t bytes);
+void CountCopy(std::uint64_t elements);
+
+// Counts one call of op with its estimated flops and wall time.
+class ScopedOp {
+ public:
+  ScopedOp(MatrixOp op, double flops)
+      : op_(op), flops_(flops), start_(std::chrono::steady_clock::now()) {}
+  ScopedOp(const ScopedOp &) = delete;
+  ScopedOp &operator=(const ScopedOp &) = delete;
+  ~ScopedOp() {
+    const auto elapsed = std::chrono::steady_clock::now() - start_;
+    CountOp(op_, std::uint64_t(flops_),
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                .count());
+  }
+
+ private:
+  MatrixOp op_;
+  double flops_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace s21
+
+#ifdef S21_MATRIX_INSTRUMENT
+#define S21_INSTRUMENT_OP(op, flops) \
+  s21::ScopedOp s21_scoped_op(s21::MatrixOp::op, flops)
+#define S21_INSTRUMENT_ALLOC(bytes) s21::CountAllocation(bytes)
+#define S21_INSTRUMENT_FREE(bytes) s21::CountFree(bytes)
+#define S21_INSTRUMENT_COPY(elements) s21::CountCopy(elements)
+#else
+#define S21_INSTRUMENT_OP(op, flops) ((void)0)
+#define S21_INSTRUMENT_ALLOC(bytes) ((void)0)
+#define S21_INSTRUMENT_FREE(bytes) ((void)0)
+#define S21_INSTRUMENT_COPY(elements) ((void)0)
+#endif
+
+#endif  // SRC_S21_INSTRUMENT_H_
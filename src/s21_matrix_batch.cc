@@ -0,0 +1,391 @@
+#include "s21_matrix_batch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+#include "s21_thread_pool.h"
+
+namespace {
+
+// Lanes handled together by the factorizations; their working set of two
+// n x n matrices per lane stays in L2 up to 16 x 16.
+constexpr int kLaneBlock = 256;
+// Elements handled together by the element-wise operations.
+constexpr long kElementBlock = 1 << 14;
+// Below this many multiply-adds waking the thread pool costs more than it
+// saves.
+constexpr long kParallelWork = 1 << 16;
+
+// Runs body(begin, end) over [0, count) in blocks of at most block, spread
+// over the thread pool once work is large enough.
+void ForBlocks(long count, long block, long work,
+               const std::function<void(long, long)> &body) {
+  const long blocks = (count + block - 1) / block;
+  auto run = [&](int index) {
+    body(index * block, std::min(count, (index + 1) * block));
+  };
+  if (blocks > 1 && work >= kParallelWork &&
+      s21::ThreadPool::Instance().ThreadCount() > 1) {
+    s21::ThreadPool::Instance().ParallelFor(int(blocks), run);
+  } else {
+    for (long index = 0; index < blocks; index++) run(int(index));
+  }
+}
+
+// n * eps * max_j |a_ij| for row i of each lane, in the layout of a. A pivot
+// at or below the value of the row it came from makes that lane singular,
+// the same test S21Matrix applies to its LU pivots.
+void RowTolerances(int n, int len, const double *a, double *tolerance) {
+  std::fill_n(tolerance, std::size_t(n) * len, 0.0);
+  for (int i = 0; i < n; i++) {
+    double *row = tolerance + std::ptrdiff_t(i) * len;
+    for (int j = 0; j < n; j++) {
+      const double *element = a + std::ptrdiff_t(i * n + j) * len;
+      for (int l = 0; l < len; l++) {
+        row[l] = std::max(row[l], std::fabs(element[l]));
+      }
+    }
+    for (int l = 0; l < len; l++) {
+      row[l] *= n * std::numeric_limits<double>::epsilon();
+    }
+  }
+}
+
+// Partial pivoting for column k of n x n matrices whose element (i, j) of
+// lane l is a[(i * n + j) * len + l]: swaps each lane's largest row from k
+// on into row k, in a, in the row tolerances and, when given, in x.
+// pivot_row and best receive the row chosen for each lane and the magnitude
+// of its pivot.
+void PivotLanes(int n, int k, int len, double *a, double *x, double *tolerance,
+                int *pivot_row, double *best) {
+  const double *column = a + std::ptrdiff_t(k * n + k) * len;
+  for (int l = 0; l < len; l++) {
+    best[l] = std::fabs(column[l]);
+    pivot_row[l] = k;
+  }
+  for (int i = k + 1; i < n; i++) {
+    const double *candidate = a + std::ptrdiff_t(i * n + k) * len;
+    for (int l = 0; l < len; l++) {
+      if (std::fabs(candidate[l]) > best[l]) {
+        best[l] = std::fabs(candidate[l]);
+        pivot_row[l] = i;
+      }
+    }
+  }
+  for (int l = 0; l < len; l++) {
+    const int p = pivot_row[l];
+    if (p == k) continue;
+    std::swap(tolerance[std::ptrdiff_t(k) * len + l],
+              tolerance[std::ptrdiff_t(p) * len + l]);
+    for (int j = x == nullptr ? k : 0; j < n; j++) {
+      std::swap(a[std::ptrdiff_t(k * n + j) * len + l],
+                a[std::ptrdiff_t(p * n + j) * len + l]);
+    }
+    for (int j = 0; x != nullptr && j < n; j++) {
+      std::swap(x[std::ptrdiff_t(k * n + j) * len + l],
+                x[std::ptrdiff_t(p * n + j) * len + l]);
+    }
+  }
+}
+
+}  // namespace
+
+/** CONSTRUCTORS **/
+S21MatrixBatch::S21MatrixBatch() : count_(0), rows_(0), cols_(0) {}
+
+S21MatrixBatch::S21MatrixBatch(int count, int rows, int cols)
+    : count_(count), rows_(rows), cols_(cols) {
+  if (count_ < 1 || rows_ < 1 || cols_ < 1) {
+    throw std::out_of_range("Incorrect matrix size");
+  }
+  data_.assign(std::size_t(count_) * rows_ * cols_, 0.0);
+}
+
+/** ACCESS **/
+S21Matrix S21MatrixBatch::Get(int index) const {
+  if (index < 0 || index >= count_) {
+    throw std::out_of_range("Incorrect Index");
+  }
+  S21Matrix matrix(rows_, cols_);
+  for (int i = 0; i < rows_; i++) {
+    for (int j = 0; j < cols_; j++) matrix(i, j) = lanes(i, j)[index];
+  }
+  return matrix;
+}
+
+void S21MatrixBatch::Set(int index, const S21Matrix &matrix) {
+  if (index < 0 || index >= count_) {
+    throw std::out_of_range("Incorrect Index");
+  }
+  if (matrix.GetRows() != rows_ || matrix.GetCols() != cols_) {
+    throw std::out_of_range(
+        "Incorrect input, matrices should have the same size");
+  }
+  for (int i = 0; i < rows_; i++) {
+    for (int j = 0; j < cols_; j++) lanes(i, j)[index] = matrix(i, j);
+  }
+}
+
+/** METHODS **/
+bool S21MatrixBatch::EqMatrix(const S21MatrixBatch &other) const {
+  if (count_ != other.count_ || rows_ != other.rows_ || cols_ != other.cols_) {
+    return false;
+  }
+  for (std::size_t e = 0; e < data_.size(); e++) {
+    if (std::fabs(data_[e] - other.data_[e]) > 1e-7) return false;
+  }
+  return true;
+}
+
+void S21MatrixBatch::SumMatrix(const S21MatrixBatch &other) {
+  check_same_size(other);
+  double *a = data_.data();
+  const double *b = other.data_.data();
+  ForBlocks(data_.size(), kElementBlock, data_.size(), [&](long lo, long hi) {
+    for (long e = lo; e < hi; e++) a[e] += b[e];
+  });
+}
+
+void S21MatrixBatch::SubMatrix(const S21MatrixBatch &other) {
+  check_same_size(other);
+  double *a = data_.data();
+  const double *b = other.data_.data();
+  ForBlocks(data_.size(), kElementBlock, data_.size(), [&](long lo, long hi) {
+    for (long e = lo; e < hi; e++) a[e] -= b[e];
+  });
+}
+
+void S21MatrixBatch::MulNumber(const double num) {
+  double *a = data_.data();
+  ForBlocks(data_.size(), kElementBlock, data_.size(), [&](long lo, long hi) {
+    for (long e = lo; e < hi; e++) a[e] *= num;
+  });
+}
+
+void S21MatrixBatch::MulMatrix(const S21MatrixBatch &other) {
+  *this = *this * other;
+}
+
+S21MatrixBatch S21MatrixBatch::Transpose() const {
+  S21MatrixBatch result(count_, cols_, rows_);
+  for (int i = 0; i < rows_; i++) {
+    for (int j = 0; j < cols_; j++) {
+      std::copy_n(lanes(i, j), count_, result.lanes(j, i));
+    }
+  }
+  return result;
+}
+
+std::vector<double> S21MatrixBatch::Determinant() const {
+  if (rows_ != cols_) {
+    throw std::out_of_range("rows and cols aren't equal");
+  }
+  const int n = rows_;
+  std::vector<double> determ(count_, 1.0);
+  ForBlocks(count_, kLaneBlock, long(n) * n * n * count_, [&](long lo,
+                                                               long hi) {
+    const int len = int(hi - lo);
+    std::vector<double> a(std::size_t(n) * n * len), best(len);
+    std::vector<double> tolerance(std::size_t(n) * len);
+    std::vector<int> pivot_row(len);
+    std::vector<char> singular(len, 0);
+    for (int e = 0; e < n * n; e++) {
+      std::copy_n(data_.data() + std::ptrdiff_t(e) * count_ + lo, len,
+                  a.data() + std::ptrdiff_t(e) * len);
+    }
+    RowTolerances(n, len, a.data(), tolerance.data());
+    double *det = determ.data() + lo;
+    for (int k = 0; k < n; k++) {
+      PivotLanes(n, k, len, a.data(), nullptr, tolerance.data(),
+                 pivot_row.data(), best.data());
+      const double *pivot = a.data() + std::ptrdiff_t(k * n + k) * len;
+      const double *bound = tolerance.data() + std::ptrdiff_t(k) * len;
+      for (int l = 0; l < len; l++) {
+        det[l] *= pivot_row[l] == k ? pivot[l] : -pivot[l];
+        if (best[l] <= bound[l]) singular[l] = 1;
+      }
+      for (int i = k + 1; i < n; i++) {
+        double *below = a.data() + std::ptrdiff_t(i * n + k) * len;
+        for (int l = 0; l < len; l++) {
+          below[l] = pivot[l] == 0 ? 0 : below[l] / pivot[l];
+        }
+        for (int j = k + 1; j < n; j++) {
+          double *target = a.data() + std::ptrdiff_t(i * n + j) * len;
+          const double *source = a.data() + std::ptrdiff_t(k * n + j) * len;
+          for (int l = 0; l < len; l++) target[l] -= below[l] * source[l];
+        }
+      }
+    }
+    // An exact zero, not the rounding residue, like S21Matrix::Determinant.
+    for (int l = 0; l < len; l++) {
+      if (singular[l]) det[l] = 0;
+    }
+  });
+  return determ;
+}
+
+S21MatrixBatch S21MatrixBatch::InverseMatrix() const {
+  if (rows_ != cols_) {
+    throw std::out_of_range("rows and cols aren't equal");
+  }
+  const int n = rows_;
+  S21MatrixBatch result(count_, n, n);
+  const long blocks = (count_ + kLaneBlock - 1) / kLaneBlock;
+  std::vector<char> singular(blocks, 0);
+  // Gauss-Jordan on [A | I], one lane per matrix.
+  ForBlocks(count_, kLaneBlock, 2L * n * n * n * count_, [&](long lo,
+                                                              long hi) {
+    const int len = int(hi - lo);
+    std::vector<double> a(std::size_t(n) * n * len), x(a.size(), 0.0);
+    std::vector<double> best(len), tolerance(std::size_t(n) * len);
+    std::vector<int> pivot_row(len);
+    for (int e = 0; e < n * n; e++) {
+      std::copy_n(data_.data() + std::ptrdiff_t(e) * count_ + lo, len,
+                  a.data() + std::ptrdiff_t(e) * len);
+    }
+    RowTolerances(n, len, a.data(), tolerance.data());
+    for (int i = 0; i < n; i++) {
+      std::fill_n(x.data() + std::ptrdiff_t(i * n + i) * len, len, 1.0);
+    }
+    for (int k = 0; k < n; k++) {
+      PivotLanes(n, k, len, a.data(), x.data(), tolerance.data(),
+                 pivot_row.data(), best.data());
+      double *pivot = a.data() + std::ptrdiff_t(k * n + k) * len;
+      const double *bound = tolerance.data() + std::ptrdiff_t(k) * len;
+      for (int l = 0; l < len; l++) {
+        if (best[l] <= bound[l]) {
+          singular[lo / kLaneBlock] = 1;
+          pivot[l] = 1;
+        }
+        best[l] = pivot[l];
+      }
+      for (int j = 0; j < n; j++) {
+        double *ak = a.data() + std::ptrdiff_t(k * n + j) * len;
+        double *xk = x.data() + std::ptrdiff_t(k * n + j) * len;
+        for (int l = 0; l < len; l++) {
+          if (j >= k) ak[l] /= best[l];
+          xk[l] /= best[l];
+        }
+      }
+      for (int i = 0; i < n; i++) {
+        if (i == k) continue;
+        const double *factor = a.data() + std::ptrdiff_t(i * n + k) * len;
+        std::copy_n(factor, len, best.data());
+        for (int j = 0; j < n; j++) {
+          const std::ptrdiff_t ij = std::ptrdiff_t(i * n + j) * len;
+          const std::ptrdiff_t kj = std::ptrdiff_t(k * n + j) * len;
+          if (j >= k) {
+            for (int l = 0; l < len; l++) a[ij + l] -= best[l] * a[kj + l];
+          }
+          for (int l = 0; l < len; l++) x[ij + l] -= best[l] * x[kj + l];
+        }
+      }
+    }
+    for (int e = 0; e < n * n; e++) {
+      std::copy_n(x.data() + std::ptrdiff_t(e) * len, len,
+                  result.data_.data() + std::ptrdiff_t(e) * count_ + lo);
+    }
+  });
+  if (std::find(singular.begin(), singular.end(), 1) != singular.end()) {
+    throw std::out_of_range("Determinant must not be zero");
+  }
+  return result;
+}
+
+/** OVERLOAD OPERATORS **/
+S21MatrixBatch S21MatrixBatch::operator+(const S21MatrixBatch &other) const {
+  S21MatrixBatch result(*this);
+  result.SumMatrix(other);
+  return result;
+}
+
+S21MatrixBatch S21MatrixBatch::operator-(const S21MatrixBatch &other) const {
+  S21MatrixBatch result(*this);
+  result.SubMatrix(other);
+  return result;
+}
+
+S21MatrixBatch S21MatrixBatch::operator*(const S21MatrixBatch &other) const {
+  if (count_ != other.count_) {
+    throw std::out_of_range(
+        "Incorrect input, matrices should have the same size");
+  }
+  if (cols_ != other.rows_) {
+    throw std::out_of_range("rows and cols aren't equal");
+  }
+  S21MatrixBatch result(count_, rows_, other.cols_);
+  const long work = long(rows_) * cols_ * other.cols_;
+  ForBlocks(count_, kLaneBlock, work * count_, [&](long lo, long hi) {
+    const int len = int(hi - lo);
+    for (int i = 0; i < rows_; i++) {
+      for (int j = 0; j < result.cols_; j++) {
+        double *c = result.lanes(i, j) + lo;
+        for (int p = 0; p < cols_; p++) {
+          const double *a = lanes(i, p) + lo;
+          const double *b = other.lanes(p, j) + lo;
+          for (int l = 0; l < len; l++) c[l] += a[l] * b[l];
+        }
+      }
+    }
+  });
+  return result;
+}
+
+S21MatrixBatch S21MatrixBatch::operator*(const double &num) const {
+  S21MatrixBatch result(*this);
+  result.MulNumber(num);
+  return result;
+}
+
+bool S21MatrixBatch::operator==(const S21MatrixBatch &other) const {
+  return EqMatrix(other);
+}
+
+S21MatrixBatch &S21MatrixBatch::operator+=(const S21MatrixBatch &other) {
+  SumMatrix(other);
+  return *this;
+}
+
+S21MatrixBatch &S21MatrixBatch::operator-=(const S21MatrixBatch &other) {
+  SubMatrix(other);
+  return *this;
+}
+
+S21MatrixBatch &S21MatrixBatch::operator*=(const S21MatrixBatch &other) {
+  MulMatrix(other);
+  return *this;
+}
+
+S21MatrixBatch &S21MatrixBatch::operator*=(const double &num) {
+  MulNumber(num);
+  return *this;
+}
+
+double &S21MatrixBatch::operator()(const int index, const int row,
+                                   const int col) {
+  if (index < 0 || index >= count_ || rows_ <= row || cols_ <= col ||
+      row < 0 || col < 0) {
+    throw std::out_of_range("Incorrect Index");
+  }
+  return lanes(row, col)[index];
+}
+
+const double &S21MatrixBatch::operator()(const int index, const int row,
+                                         const int col) const {
+  if (index < 0 || index >= count_ || rows_ <= row || cols_ <= col ||
+      row < 0 || col < 0) {
+    throw std::out_of_range("Incorrect Index");
+  }
+  return lanes(row, col)[index];
+}
+
+/** HELP FUNCTIONS **/
+void S21MatrixBatch::check_same_size(const S21MatrixBatch &other) const {
+  if (count_ != other.count_ || rows_ != other.rows_ || cols_ != other.cols_) {
+    throw std::out_of_range(
+        "Incorrect input, matrices should have the same size");
+  }
+}
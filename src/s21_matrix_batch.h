@@ -0,0 +1,66 @@
+#ifndef SRC_S21_MATRIX_BATCH_H_
+#define SRC_S21_MATRIX_BATCH_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+/*
+ * count matrices of one shape stored structure-of-arrays: element (i, j) of
+ * every matrix sits in one contiguous run, so element (i, j) of matrix index
+ * is data[(i * cols + j) * count + index]. Every operation applies the same
+ * arithmetic to all matrices at once, with the batch as the innermost loop,
+ * which the compiler turns into SIMD lanes. Batches are split into blocks
+ * of lanes that stay in cache and are spread over the thread pool.
+ */
+class S21MatrixBatch {
+ public:
+  S21MatrixBatch();
+  S21MatrixBatch(int count, int rows, int cols);
+
+  int GetCount() const { return count_; }
+  int GetRows() const { return rows_; }
+  int GetCols() const { return cols_; }
+
+  S21Matrix Get(int index) const;
+  void Set(int index, const S21Matrix &matrix);
+
+  bool EqMatrix(const S21MatrixBatch &other) const;
+  void SumMatrix(const S21MatrixBatch &other);
+  void SubMatrix(const S21MatrixBatch &other);
+  void MulNumber(const double num);
+  // Multiplies every matrix by the matrix with the same index in other.
+  void MulMatrix(const S21MatrixBatch &other);
+  S21MatrixBatch Transpose() const;
+  std::vector<double> Determinant() const;
+  // Throws if any of the matrices is singular.
+  S21MatrixBatch InverseMatrix() const;
+
+  S21MatrixBatch operator+(const S21MatrixBatch &other) const;
+  S21MatrixBatch operator-(const S21MatrixBatch &other) const;
+  S21MatrixBatch operator*(const S21MatrixBatch &other) const;
+  S21MatrixBatch operator*(const double &num) const;
+  bool operator==(const S21MatrixBatch &other) const;
+  S21MatrixBatch &operator+=(const S21MatrixBatch &other);
+  S21MatrixBatch &operator-=(const S21MatrixBatch &other);
+  S21MatrixBatch &operator*=(const S21MatrixBatch &other);
+  S21MatrixBatch &operator*=(const double &num);
+  double &operator()(const int index, const int row, const int col);
+  const double &operator()(const int index, const int row,
+                           const int col) const;
+
+ private:
+  int count_, rows_, cols_;
+  std::vector<double> data_;
+
+  double *lanes(int row, int col) {
+    return data_.data() + std::ptrdiff_t(row * cols_ + col) * count_;
+  }
+  const double *lanes(int row, int col) const {
+    return data_.data() + std::ptrdiff_t(row * cols_ + col) * count_;
+  }
+  void check_same_size(const S21MatrixBatch &other) const;
+};
+
+#endif  // SRC_S21_MATRIX_BATCH_H_
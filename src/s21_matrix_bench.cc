@@ -0,0 +1,321 @@
+#include <benchmark/benchmark.h>
+
+#include <utility>
+
+#include "s21_matrix_oop.h"
+
+template <typename Scalar = double>
+static S21BasicMatrix<Scalar> Pattern(int size, int seed) {
+  S21BasicMatrix<Scalar> matrix(size, size);
+  for (int i = 0; i < size; i++) {
+    for (int j = 0; j < size; j++) {
+      matrix(i, j) = ((i * 31 + j * 17 + seed) % 23) / 8.0 - 1.25;
+    }
+    // Diagonally dominant, so every size is invertible.
+    matrix(i, i) += size;
+  }
+  return matrix;
+}
+
+// Square sizes from 8 to 1024; the O(n^3) operations stop at 512.
+static void Sizes(benchmark::internal::Benchmark *bench) {
+  bench->RangeMultiplier(4)->Range(8, 1024);
+}
+
+static void CubicSizes(benchmark::internal::Benchmark *bench) {
+  bench->RangeMultiplier(4)->Range(8, 512);
+}
+
+template <typename Scalar = double>
+static void SetElements(benchmark::State &state, int operands) {
+  const long size = state.range(0);
+  state.SetBytesProcessed(state.iterations() * operands * size * size *
+                          long(sizeof(Scalar)));
+}
+
+static void BM_Construct(benchmark::State &state) {
+  const int size = state.range(0);
+  for (auto _ : state) {
+    S21Matrix matrix(size, size);
+    benchmark::DoNotOptimize(matrix(0, 0));
+  }
+  SetElements(state, 1);
+}
+BENCHMARK(BM_Construct)->Apply(Sizes);
+
+static void BM_Copy(benchmark::State &state) {
+  S21Matrix source = Pattern(state.range(0), 1);
+  for (auto _ : state) {
+    S21Matrix copy(source);
+    benchmark::DoNotOptimize(copy(0, 0));
+  }
+  SetElements(state, 2);
+}
+BENCHMARK(BM_Copy)->Apply(Sizes);
+
+static void BM_Move(benchmark::State &state) {
+  S21Matrix source = Pattern(state.range(0), 1);
+  for (auto _ : state) {
+    S21Matrix moved(std::move(source));
+    source = std::move(moved);
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BM_Move)->Apply(Sizes);
+
+// Grows a matrix of 64 columns one row at a time up to range(0) rows.
+static void BM_AppendRows(benchmark::State &state) {
+  const int rows = state.range(0);
+  for (auto _ : state) {
+    S21Matrix matrix(1, 64);
+    for (int i = 1; i < rows; i++) {
+      matrix.SetRows(i + 1);
+      matrix(i, 0) = i;
+    }
+    benchmark::DoNotOptimize(matrix(0, 0));
+  }
+  state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_AppendRows)->Arg(1000)->Arg(10000);
+
+static void BM_EqMatrix(benchmark::State &state) {
+  S21Matrix lhs = Pattern(state.range(0), 1);
+  S21Matrix rhs(lhs);
+  for (auto _ : state) benchmark::DoNotOptimize(lhs.EqMatrix(rhs));
+  SetElements(state, 2);
+}
+BENCHMARK(BM_EqMatrix)->Apply(Sizes);
+
+static void BM_SumMatrix(benchmark::State &state) {
+  S21Matrix lhs = Pattern(state.range(0), 1);
+  S21Matrix rhs = Pattern(state.range(0), 2);
+  for (auto _ : state) {
+    lhs.SumMatrix(rhs);
+    benchmark::ClobberMemory();
+  }
+  SetElements(state, 3);
+}
+BENCHMARK(BM_SumMatrix)->Apply(Sizes);
+
+static void BM_SubMatrix(benchmark::State &state) {
+  S21Matrix lhs = Pattern(state.range(0), 1);
+  S21Matrix rhs = Pattern(state.range(0), 2);
+  for (auto _ : state) {
+    lhs.SubMatrix(rhs);
+    benchmark::ClobberMemory();
+  }
+  SetElements(state, 3);
+}
+BENCHMARK(BM_SubMatrix)->Apply(Sizes);
+
+static void BM_MulNumber(benchmark::State &state) {
+  S21Matrix matrix = Pattern(state.range(0), 1);
+  for (auto _ : state) {
+    matrix.MulNumber(1.0000001);
+    benchmark::ClobberMemory();
+  }
+  SetElements(state, 2);
+}
+BENCHMARK(BM_MulNumber)->Apply(Sizes);
+
+static void BM_MulMatrix(benchmark::State &state) {
+  const int size = state.range(0);
+  S21Matrix lhs = Pattern(size, 1);
+  S21Matrix rhs = Pattern(size, 2);
+  for (auto _ : state) {
+    S21Matrix product(lhs);
+    product.MulMatrix(rhs);
+    benchmark::DoNotOptimize(product(0, 0));
+  }
+  state.counters["flops"] = benchmark::Counter(
+      2.0 * size * size * size, benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_MulMatrix)->Apply(CubicSizes)->UseRealTime();
+
+static void BM_MulMatrixStrassen(benchmark::State &state) {
+  const int size = state.range(0);
+  S21Matrix lhs = Pattern(size, 1);
+  S21Matrix rhs = Pattern(size, 2);
+  for (auto _ : state) {
+    S21Matrix product(lhs);
+    product.MulMatrix(rhs, S21MulPolicy::kStrassen);
+    benchmark::DoNotOptimize(product(0, 0));
+  }
+  state.counters["flops"] = benchmark::Counter(
+      2.0 * size * size * size, benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_MulMatrixStrassen)->Arg(1024)->Arg(2048)->UseRealTime();
+
+// C = A * B + C in place, against the temporary that c += a * b builds.
+static void BM_GemmUpdate(benchmark::State &state) {
+  const int size = state.range(0);
+  S21Matrix lhs = Pattern(size, 1);
+  S21Matrix rhs = Pattern(size, 2);
+  S21Matrix product = Pattern(size, 3);
+  for (auto _ : state) {
+    product.Gemm(1.0, lhs, rhs, 1.0);
+    benchmark::DoNotOptimize(product(0, 0));
+  }
+  state.counters["flops"] = benchmark::Counter(
+      2.0 * size * size * size, benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_GemmUpdate)->Apply(CubicSizes)->UseRealTime();
+
+// y = A * x with a single column, against the packed GEMM route.
+static void BM_Gemv(benchmark::State &state) {
+  const int size = state.range(0);
+  S21Matrix matrix = Pattern(size, 1);
+  S21Matrix x = Pattern(size, 2);
+  x.SetCols(1);
+  S21Matrix y(size, 1);
+  for (auto _ : state) {
+    y.Gemm(1.0, matrix, x, 0.0);
+    benchmark::DoNotOptimize(y(0, 0));
+  }
+  SetElements(state, 1);
+}
+BENCHMARK(BM_Gemv)->Apply(Sizes)->Arg(4096)->UseRealTime();
+
+// BM_SumMatrix and BM_MulMatrix for the other element types.
+template <typename Scalar>
+static void BM_SumMatrixOf(benchmark::State &state) {
+  S21BasicMatrix<Scalar> lhs = Pattern<Scalar>(state.range(0), 1);
+  S21BasicMatrix<Scalar> rhs = Pattern<Scalar>(state.range(0), 2);
+  for (auto _ : state) {
+    lhs.SumMatrix(rhs);
+    benchmark::ClobberMemory();
+  }
+  SetElements<Scalar>(state, 3);
+}
+BENCHMARK_TEMPLATE(BM_SumMatrixOf, float)->Apply(Sizes);
+BENCHMARK_TEMPLATE(BM_SumMatrixOf, long double)->Apply(Sizes);
+
+template <typename Scalar>
+static void BM_MulMatrixOf(benchmark::State &state) {
+  const int size = state.range(0);
+  S21BasicMatrix<Scalar> lhs = Pattern<Scalar>(size, 1);
+  S21BasicMatrix<Scalar> rhs = Pattern<Scalar>(size, 2);
+  for (auto _ : state) {
+    S21BasicMatrix<Scalar> product(lhs);
+    product.MulMatrix(rhs);
+    benchmark::DoNotOptimize(product(0, 0));
+  }
+  state.counters["flops"] = benchmark::Counter(
+      2.0 * size * size * size, benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK_TEMPLATE(BM_MulMatrixOf, float)->Apply(CubicSizes)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_MulMatrixOf, long double)
+    ->Apply(CubicSizes)
+    ->UseRealTime();
+
+static void BM_Transpose(benchmark::State &state) {
+  S21Matrix matrix = Pattern(state.range(0), 1);
+  for (auto _ : state) {
+    S21Matrix transposed = matrix.Transpose();
+    benchmark::DoNotOptimize(transposed(0, 0));
+  }
+  SetElements(state, 2);
+}
+BENCHMARK(BM_Transpose)->Apply(Sizes);
+
+static void BM_TransposeInPlace(benchmark::State &state) {
+  S21Matrix matrix = Pattern(state.range(0), 1);
+  for (auto _ : state) {
+    matrix.TransposeInPlace();
+    benchmark::ClobberMemory();
+  }
+  SetElements(state, 2);
+}
+BENCHMARK(BM_TransposeInPlace)->Apply(Sizes);
+
+// Matrices cache their factors, so every iteration writes an element first
+// to time the factorization instead of the cache.
+static void Touch(S21Matrix &matrix) { matrix(0, 0) = matrix(0, 0); }
+
+// Symmetric and diagonally dominant, so positive definite.
+static S21Matrix SpdPattern(int size) {
+  S21Matrix matrix = Pattern(size, 1);
+  matrix += matrix.Transpose();
+  return matrix;
+}
+
+static void BM_Determinant(benchmark::State &state) {
+  S21Matrix matrix = Pattern(state.range(0), 1);
+  for (auto _ : state) {
+    Touch(matrix);
+    benchmark::DoNotOptimize(matrix.Determinant());
+  }
+}
+BENCHMARK(BM_Determinant)->Apply(CubicSizes);
+
+static void BM_InverseMatrix(benchmark::State &state) {
+  S21Matrix matrix = Pattern(state.range(0), 1);
+  for (auto _ : state) {
+    Touch(matrix);
+    S21Matrix inverse = matrix.InverseMatrix();
+    benchmark::DoNotOptimize(inverse(0, 0));
+  }
+}
+BENCHMARK(BM_InverseMatrix)->Apply(CubicSizes);
+
+// 64 right-hand sides, against the inverse-then-multiply route it replaces.
+static void BM_Solve(benchmark::State &state) {
+  S21Matrix matrix = Pattern(state.range(0), 1);
+  S21Matrix rhs = Pattern(state.range(0), 2);
+  rhs.SetCols(64);
+  for (auto _ : state) {
+    Touch(matrix);
+    S21Matrix solution = matrix.Solve(rhs);
+    benchmark::DoNotOptimize(solution(0, 0));
+  }
+}
+BENCHMARK(BM_Solve)->Arg(64)->Arg(512)->Arg(2000)->UseRealTime();
+
+static void BM_SolveByInverse(benchmark::State &state) {
+  S21Matrix matrix = Pattern(state.range(0), 1);
+  S21Matrix rhs = Pattern(state.range(0), 2);
+  rhs.SetCols(64);
+  for (auto _ : state) {
+    Touch(matrix);
+    S21Matrix solution = matrix.InverseMatrix() * rhs;
+    benchmark::DoNotOptimize(solution(0, 0));
+  }
+}
+BENCHMARK(BM_SolveByInverse)->Arg(64)->Arg(512)->Arg(2000)->UseRealTime();
+
+// The same positive definite operand through Cholesky and through LU.
+static void BM_DeterminantSpd(benchmark::State &state, S21Factorization hint) {
+  S21Matrix matrix = SpdPattern(state.range(0));
+  for (auto _ : state) {
+    Touch(matrix);
+    benchmark::DoNotOptimize(matrix.Determinant(hint));
+  }
+}
+BENCHMARK_CAPTURE(BM_DeterminantSpd, cholesky, S21Factorization::kAuto)
+    ->Apply(CubicSizes);
+BENCHMARK_CAPTURE(BM_DeterminantSpd, lu, S21Factorization::kLU)
+    ->Apply(CubicSizes);
+
+static void BM_InverseSpd(benchmark::State &state, S21Factorization hint) {
+  S21Matrix matrix = SpdPattern(state.range(0));
+  for (auto _ : state) {
+    Touch(matrix);
+    S21Matrix inverse = matrix.InverseMatrix(hint);
+    benchmark::DoNotOptimize(inverse(0, 0));
+  }
+}
+BENCHMARK_CAPTURE(BM_InverseSpd, cholesky, S21Factorization::kAuto)
+    ->Apply(CubicSizes);
+BENCHMARK_CAPTURE(BM_InverseSpd, lu, S21Factorization::kLU)
+    ->Apply(CubicSizes);
+
+static void BM_CalcComplements(benchmark::State &state) {
+  S21Matrix matrix = Pattern(state.range(0), 1);
+  for (auto _ : state) {
+    S21Matrix complements = matrix.CalcComplements();
+    benchmark::DoNotOptimize(complements(0, 0));
+  }
+}
+BENCHMARK(BM_CalcComplements)->Apply(CubicSizes);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,185 @@
+#ifndef SRC_S21_MATRIX_EXPR_H_
+#define SRC_S21_MATRIX_EXPR_H_
+
+#include <stdexcept>
+
+#include "s21_matrix_oop.h"
+
+/*
+ * Opt-in lazy evaluation of element-wise arithmetic. Wrapping an operand in
+ * S21Lazy() makes +, - and scalar * build expression nodes instead of
+ * matrices; the whole chain is then computed in a single fused pass when it
+ * is assigned to, or used to construct, an S21Matrix:
+ *
+ *   S21Matrix x = S21Lazy(a) + b - c * 2.0;
+ *
+ * Nodes hold their operands by value and matrices by reference, so an
+ * expression must not outlive the matrices it reads. Multiplying an
+ * expression by a matrix evaluates it first.
+ */
+template <typename E>
+class S21Expr {
+ public:
+  const E &self() const { return static_cast<const E &>(*this); }
+  int rows() const { return self().rows(); }
+  int cols() const { return self().cols(); }
+  double at(int i, int j) const { return self().at(i, j); }
+};
+
+class S21MatrixRef : public S21Expr<S21MatrixRef> {
+ public:
+  explicit S21MatrixRef(const S21Matrix &matrix)
+      : rows_(matrix.rows_),
+        cols_(matrix.cols_),
+        ld_(matrix.ld_),
+        data_(matrix.matrix_) {}
+  int rows() const { return rows_; }
+  int cols() const { return cols_; }
+  double at(int i, int j) const { return data_[std::ptrdiff_t(i) * ld_ + j]; }
+
+ private:
+  int rows_, cols_, ld_;
+  const double *data_;
+};
+
+template <typename L, typename R, typename Op>
+class S21BinaryExpr : public S21Expr<S21BinaryExpr<L, R, Op>> {
+ public:
+  S21BinaryExpr(const L &lhs, const R &rhs) : lhs_(lhs), rhs_(rhs) {
+    if (lhs.rows() != rhs.rows() || lhs.cols() != rhs.cols()) {
+      throw std::out_of_range(
+          "Incorrect input, matrices should have the same size");
+    }
+  }
+  int rows() const { return lhs_.rows(); }
+  int cols() const { return lhs_.cols(); }
+  double at(int i, int j) const {
+    return Op::Apply(lhs_.at(i, j), rhs_.at(i, j));
+  }
+
+ private:
+  L lhs_;
+  R rhs_;
+};
+
+template <typename E>
+class S21ScaledExpr : public S21Expr<S21ScaledExpr<E>> {
+ public:
+  S21ScaledExpr(const E &expr, double num) : expr_(expr), num_(num) {}
+  int rows() const { return expr_.rows(); }
+  int cols() const { return expr_.cols(); }
+  double at(int i, int j) const { return expr_.at(i, j) * num_; }
+
+ private:
+  E expr_;
+  double num_;
+};
+
+struct S21AddOp {
+  static double Apply(double a, double b) { return a + b; }
+};
+
+struct S21SubOp {
+  static double Apply(double a, double b) { return a - b; }
+};
+
+inline S21MatrixRef S21Lazy(const S21Matrix &matrix) {
+  return S21MatrixRef(matrix);
+}
+
+template <typename L, typename R>
+S21BinaryExpr<L, R, S21AddOp> operator+(const S21Expr<L> &lhs,
+                                        const S21Expr<R> &rhs) {
+  return {lhs.self(), rhs.self()};
+}
+
+template <typename L>
+S21BinaryExpr<L, S21MatrixRef, S21AddOp> operator+(const S21Expr<L> &lhs,
+                                                   const S21Matrix &rhs) {
+  return {lhs.self(), S21MatrixRef(rhs)};
+}
+
+template <typename R>
+S21BinaryExpr<S21MatrixRef, R, S21AddOp> operator+(const S21Matrix &lhs,
+                                                   const S21Expr<R> &rhs) {
+  return {S21MatrixRef(lhs), rhs.self()};
+}
+
+template <typename L, typename R>
+S21BinaryExpr<L, R, S21SubOp> operator-(const S21Expr<L> &lhs,
+                                        const S21Expr<R> &rhs) {
+  return {lhs.self(), rhs.self()};
+}
+
+template <typename L>
+S21BinaryExpr<L, S21MatrixRef, S21SubOp> operator-(const S21Expr<L> &lhs,
+                                                   const S21Matrix &rhs) {
+  return {lhs.self(), S21MatrixRef(rhs)};
+}
+
+template <typename R>
+S21BinaryExpr<S21MatrixRef, R, S21SubOp> operator-(const S21Matrix &lhs,
+                                                   const S21Expr<R> &rhs) {
+  return {S21MatrixRef(lhs), rhs.self()};
+}
+
+template <typename E>
+S21ScaledExpr<E> operator-(const S21Expr<E> &expr) {
+  return {expr.self(), -1.0};
+}
+
+template <typename E>
+S21ScaledExpr<E> operator*(const S21Expr<E> &expr, double num) {
+  return {expr.self(), num};
+}
+
+template <typename E>
+S21ScaledExpr<E> operator*(double num, const S21Expr<E> &expr) {
+  return {expr.self(), num};
+}
+
+template <typename E>
+S21Matrix operator*(const S21Expr<E> &lhs, const S21Matrix &rhs) {
+  S21Matrix result(lhs);
+  result.MulMatrix(rhs);
+  return result;
+}
+
+template <typename E>
+S21Matrix operator*(const S21Matrix &lhs, const S21Expr<E> &rhs) {
+  return lhs * S21Matrix(rhs);
+}
+
+template <typename Scalar>
+template <typename E>
+S21BasicMatrix<Scalar>::S21BasicMatrix(const S21Expr<E> &expr)
+    : S21BasicMatrix(expr.rows(), expr.cols()) {
+  assign(expr.self());
+}
+
+template <typename Scalar>
+template <typename E>
+S21BasicMatrix<Scalar> &S21BasicMatrix<Scalar>::operator=(
+    const S21Expr<E> &expr) {
+  // Every output element depends only on the inputs at the same position, so
+  // an expression that reads this matrix can still be written in place.
+  if (rows_ != expr.rows() || cols_ != expr.cols()) {
+    S21BasicMatrix tmp(expr);
+    swap(tmp);
+  } else {
+    assign(expr.self());
+  }
+  return *this;
+}
+
+template <typename Scalar>
+template <typename E>
+void S21BasicMatrix<Scalar>::assign(const E &expr) {
+  invalidate_factors();
+  for (int i = 0; i < rows_; i++) {
+    Scalar *out = row(i);
+    for (int j = 0; j < cols_; j++) out[j] = expr.at(i, j);
+  }
+}
+
+#endif  // SRC_S21_MATRIX_EXPR_H_
@@ -0,0 +1,180 @@
+#include "s21_matrix_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+#include "s21_out_of_core.h"
+
+namespace s21 {
+
+std::uint64_t Fnv1a(const void *data, std::size_t size, std::uint64_t hash) {
+  const unsigned char *bytes = static_cast<const unsigned char *>(data);
+  for (std::size_t i = 0; i < size; i++) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+S21FileHeader MakeFileHeader(int rows, int cols) {
+  constexpr int kRowAlignment = 64;
+  constexpr int kStep = kRowAlignment / sizeof(double);
+  S21FileHeader header = {};
+  std::memcpy(header.magic, kFileMagic, sizeof(header.magic));
+  header.version = kFileVersion;
+  header.dtype = kFloat64;
+  header.layout = kRowMajor;
+  header.alignment = kRowAlignment;
+  header.rows = rows;
+  header.cols = cols;
+  header.ld = (std::uint64_t(cols) + kStep - 1) / kStep * kStep;
+  header.data_offset = sizeof(header);
+  header.checksum = Fnv1a(nullptr, 0);
+  return header;
+}
+
+bool ValidFileHeader(const S21FileHeader &header, std::size_t length) {
+  if (std::memcmp(header.magic, kFileMagic, sizeof(header.magic)) != 0 ||
+      header.version != kFileVersion || header.dtype != kFloat64 ||
+      header.layout != kRowMajor) {
+    return false;
+  }
+  if (header.rows < 1 || header.rows > INT_MAX || header.cols < 1 ||
+      header.cols > INT_MAX || header.ld < header.cols ||
+      header.data_offset < sizeof(S21FileHeader) ||
+      header.data_offset % alignof(double) != 0 ||
+      header.data_offset > length) {
+    return false;
+  }
+  const std::uint64_t elements =
+      (length - header.data_offset) / sizeof(double);
+  return header.ld <= elements && header.rows <= elements / header.ld;
+}
+
+}  // namespace s21
+
+/** FILES **/
+template <>
+void S21Matrix::Save(const std::string &path) const {
+  if (matrix_ == nullptr) {
+    throw std::out_of_range("Incorrect matrix size");
+  }
+  // Rows are padded back to an aligned stride even when ld_ is dense.
+  S21FileHeader header = s21::MakeFileHeader(rows_, cols_);
+  const int ld = int(header.ld);
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out) throw std::runtime_error("Cannot open file");
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  std::vector<double> padded(ld);
+  const std::size_t bytes = sizeof(double) * ld;
+  for (int i = 0; i < rows_; i++) {
+    std::copy_n(row(i), cols_, padded.data());
+    header.checksum = s21::Fnv1a(padded.data(), bytes, header.checksum);
+    out.write(reinterpret_cast<const char *>(padded.data()), bytes);
+  }
+  out.seekp(0);
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  if (!out.flush()) throw std::runtime_error("Cannot write file");
+}
+
+template <>
+S21MappedMatrix S21Matrix::MapFile(const std::string &path,
+                                   bool verify_checksum) {
+  return S21MappedMatrix(path, verify_checksum);
+}
+
+template <>
+void S21Matrix::MulFiles(const std::string &lhs, const std::string &rhs,
+                         const std::string &result, std::size_t memory_bytes) {
+  s21::OutOfCoreGemm(lhs, rhs, result, memory_bytes);
+}
+
+/** MAPPED MATRIX **/
+S21MappedMatrix::S21MappedMatrix(const std::string &path, bool verify_checksum)
+    : mapping_(nullptr),
+      length_(0),
+      data_(nullptr),
+      rows_(0),
+      cols_(0),
+      ld_(0) {
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) throw std::runtime_error("Cannot open file");
+  struct stat status;
+  if (fstat(fd, &status) != 0 ||
+      std::size_t(status.st_size) < sizeof(S21FileHeader)) {
+    close(fd);
+    throw std::runtime_error("Incorrect file format");
+  }
+  length_ = status.st_size;
+  void *mapping = mmap(nullptr, length_, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) throw std::runtime_error("Cannot map file");
+  const S21FileHeader &header = *static_cast<const S21FileHeader *>(mapping);
+  const char *error = nullptr;
+  if (!s21::ValidFileHeader(header, length_)) {
+    error = "Incorrect file format";
+  } else if (verify_checksum &&
+             s21::Fnv1a(static_cast<const char *>(mapping) +
+                            header.data_offset,
+                        sizeof(double) * header.rows * header.ld) !=
+                 header.checksum) {
+    error = "Checksum mismatch";
+  }
+  if (error != nullptr) {
+    munmap(mapping, length_);
+    throw std::runtime_error(error);
+  }
+  mapping_ = mapping;
+  data_ = reinterpret_cast<const double *>(static_cast<const char *>(mapping) +
+                                           header.data_offset);
+  rows_ = int(header.rows);
+  cols_ = int(header.cols);
+  ld_ = std::ptrdiff_t(header.ld);
+}
+
+S21MappedMatrix::S21MappedMatrix(S21MappedMatrix &&other) noexcept
+    : mapping_(std::exchange(other.mapping_, nullptr)),
+      length_(std::exchange(other.length_, 0)),
+      data_(std::exchange(other.data_, nullptr)),
+      rows_(std::exchange(other.rows_, 0)),
+      cols_(std::exchange(other.cols_, 0)),
+      ld_(std::exchange(other.ld_, 0)) {}
+
+S21MappedMatrix &S21MappedMatrix::operator=(S21MappedMatrix &&other) noexcept {
+  if (this != &other) {
+    std::swap(mapping_, other.mapping_);
+    std::swap(length_, other.length_);
+    std::swap(data_, other.data_);
+    std::swap(rows_, other.rows_);
+    std::swap(cols_, other.cols_);
+    std::swap(ld_, other.ld_);
+  }
+  return *this;
+}
+
+S21MappedMatrix::~S21MappedMatrix() {
+  if (mapping_ != nullptr) munmap(mapping_, length_);
+}
+
+S21MatrixView S21MappedMatrix::View() const {
+  return S21MatrixView(data_, rows_, cols_, ld_, 1);
+}
+
+const double &S21MappedMatrix::operator()(const int row, const int col) const {
+  if (rows_ <= row || cols_ <= col || row < 0 || col < 0) {
+    throw std::out_of_range("Incorrect Index");
+  }
+  return data_[row * ld_ + col];
+}
@@ -0,0 +1,80 @@
+#ifndef SRC_S21_MATRIX_FILE_H_
+#define SRC_S21_MATRIX_FILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "s21_matrix_view.h"
+
+/*
+ * Binary matrix file, version 1. A 64-byte header in native byte order is
+ * followed, at data_offset, by rows * ld elements stored row by row; the
+ * cols .. ld - 1 tail of every row is zero padding that keeps rows on
+ * alignment-byte boundaries. checksum is the 64-bit FNV-1a hash of those
+ * data bytes.
+ */
+struct S21FileHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t dtype;
+  std::uint32_t layout;
+  std::uint32_t alignment;
+  std::uint64_t rows;
+  std::uint64_t cols;
+  std::uint64_t ld;
+  std::uint64_t data_offset;
+  std::uint64_t checksum;
+};
+
+static_assert(sizeof(S21FileHeader) == 64, "header must fill 64 bytes");
+
+namespace s21 {
+
+constexpr char kFileMagic[8] = {'S', '2', '1', 'M', 'A', 'T', 'R', 'X'};
+constexpr std::uint32_t kFileVersion = 1;
+enum FileDtype : std::uint32_t { kFloat64 = 1 };
+enum FileLayout : std::uint32_t { kRowMajor = 0 };
+
+std::uint64_t Fnv1a(const void *data, std::size_t size,
+                    std::uint64_t hash = 14695981039346656037ull);
+
+// Header of a rows x cols file with 64-byte aligned rows and the checksum
+// of empty data.
+S21FileHeader MakeFileHeader(int rows, int cols);
+// True when header describes a supported file of length bytes.
+bool ValidFileHeader(const S21FileHeader &header, std::size_t length);
+
+}  // namespace s21
+
+/*
+ * Read-only matrix backed by a private memory mapping of a matrix file, as
+ * returned by S21Matrix::MapFile. Opening costs O(1) in the file size:
+ * pages are read on first touch and shared with the page cache. Pass
+ * View() to the S21Matrix methods that take views, or copy it into an
+ * S21Matrix to modify it.
+ */
+class S21MappedMatrix {
+ public:
+  S21MappedMatrix(const std::string &path, bool verify_checksum);
+  S21MappedMatrix(const S21MappedMatrix &) = delete;
+  S21MappedMatrix(S21MappedMatrix &&other) noexcept;
+  S21MappedMatrix &operator=(const S21MappedMatrix &) = delete;
+  S21MappedMatrix &operator=(S21MappedMatrix &&other) noexcept;
+  ~S21MappedMatrix();
+
+  int GetRows() const { return rows_; }
+  int GetCols() const { return cols_; }
+  S21MatrixView View() const;
+  operator S21MatrixView() const { return View(); }  // NOLINT
+  const double &operator()(const int row, const int col) const;
+
+ private:
+  void *mapping_;
+  std::size_t length_;
+  const double *data_;
+  int rows_, cols_;
+  std::ptrdiff_t ld_;
+};
+
+#endif  // SRC_S21_MATRIX_FILE_H_
@@ -1,83 +1,233 @@
 #include "s21_matrix_oop.h"
 
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <new>
+
+#include "s21_gemm.h"
+#include "s21_instrument.h"
+#include "s21_simd.h"
+#include "s21_strassen.h"
+#include "s21_thread_pool.h"
+#include "s21_transpose.h"
+
+namespace {
+
+// Order of the diagonal blocks in the blocked LU and Cholesky factorizations
+// and the triangular solves.
+constexpr int kLuBlock = 64;
+
+// Splits cols right-hand-side columns into panels of whole GEMM slivers, one
+// or a few per thread, and runs body(first column, width) for each of them.
+void ForPanels(int cols, const std::function<void(int, int)> &body) {
+  const int threads = s21::ThreadPool::Instance().ThreadCount();
+  const int share = (cols + threads - 1) / threads;
+  const int panel = (share + s21::kGemmNr - 1) / s21::kGemmNr * s21::kGemmNr;
+  s21::ThreadPool::Instance().ParallelFor(
+      (cols + panel - 1) / panel, [&](int p) {
+        body(p * panel, std::min(panel, cols - p * panel));
+      });
+}
+
+/*
+ * Overwrites the n x width block x (leading dimension ldx) with inv(T) * x
+ * for the lower triangular T(i, k) = t[i * rs + k * cs], whose diagonal is
+ * taken as ones when unit is set. kLuBlock rows at a time: a triangular
+ * solve on the diagonal block, then a GEMM update of the rows below, which
+ * carries almost all of the flops.
+ */
+template <typename T>
+void LowerSolve(int n, const T *t, std::ptrdiff_t rs, std::ptrdiff_t cs,
+                bool unit, T *x, int width, int ldx) {
+  auto at = [&](int i, int k) { return t[i * rs + k * cs]; };
+  auto xr = [&](int i) { return x + std::ptrdiff_t(i) * ldx; };
+  for (int k0 = 0; k0 < n; k0 += kLuBlock) {
+    const int end = std::min(k0 + kLuBlock, n);
+    for (int i = k0; i < end; i++) {
+      T *xi = xr(i);
+      for (int k = k0; k < i; k++) {
+        const T l = at(i, k);
+        const T *xk = xr(k);
+        for (int j = 0; j < width; j++) xi[j] -= l * xk[j];
+      }
+      if (!unit) {
+        const T inverse = T(1) / at(i, i);
+        for (int j = 0; j < width; j++) xi[j] *= inverse;
+      }
+    }
+    if (end < n) {
+      s21::Gemm(n - end, width, end - k0, T(-1), t + end * rs + k0 * cs, rs,
+                cs, xr(k0), ldx, 1, T(1), xr(end), ldx);
+    }
+  }
+}
+
+// The same for an upper triangular T, from the last block upwards.
+template <typename T>
+void UpperSolve(int n, const T *t, std::ptrdiff_t rs, std::ptrdiff_t cs,
+                bool unit, T *x, int width, int ldx) {
+  auto at = [&](int i, int k) { return t[i * rs + k * cs]; };
+  auto xr = [&](int i) { return x + std::ptrdiff_t(i) * ldx; };
+  for (int k0 = (n - 1) / kLuBlock * kLuBlock; k0 >= 0; k0 -= kLuBlock) {
+    const int end = std::min(k0 + kLuBlock, n);
+    for (int i = end - 1; i >= k0; i--) {
+      T *xi = xr(i);
+      for (int k = i + 1; k < end; k++) {
+        const T u = at(i, k);
+        const T *xk = xr(k);
+        for (int j = 0; j < width; j++) xi[j] -= u * xk[j];
+      }
+      if (!unit) {
+        const T inverse = T(1) / at(i, i);
+        for (int j = 0; j < width; j++) xi[j] *= inverse;
+      }
+    }
+    if (k0 > 0) {
+      s21::Gemm(k0, width, end - k0, T(-1), t + k0 * cs, rs, cs, xr(k0), ldx,
+                1, T(1), xr(0), ldx);
+    }
+  }
+}
+
+}  // namespace
+
+// factor holds the packed LU factors with their pivot, or the Cholesky
+// factor L with its strictly upper part zeroed. The inverse is kept as well
+// once asked for, so a matrix that has been inverted holds up to three times
+// its own storage.
+template <typename Scalar>
+struct S21BasicMatrix<Scalar>::Factors {
+  S21BasicMatrix factor;
+  std::vector<int> pivot;
+  bool cholesky;
+  bool singular;
+  S21BasicMatrix inverse;
+};
+
 /** CONSTRUCTORS AND DESTRUCTOR **/
-S21Matrix::S21Matrix() {
-  rows_ = cols_ = 0;
+template <typename Scalar>
+S21BasicMatrix<Scalar>::S21BasicMatrix() {
+  rows_ = cols_ = ld_ = row_capacity_ = 0;
   matrix_ = nullptr;
 }
 
-S21Matrix::S21Matrix(int rows, int cols) : rows_(rows), cols_(cols) {
+template <typename Scalar>
+S21BasicMatrix<Scalar>::S21BasicMatrix(int rows, int cols)
+    : rows_(rows), cols_(cols) {
   create_matrix();
 }
 
-S21Matrix::S21Matrix(const S21Matrix &other)
+template <typename Scalar>
+S21BasicMatrix<Scalar>::S21BasicMatrix(const S21BasicMatrix &other)
     : rows_(other.rows_), cols_(other.cols_) {
+  S21_INSTRUMENT_OP(kCopy, 0);
   create_matrix();
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      this->matrix_[i][j] = other.matrix_[i][j];
-    }
-  }
+  copy_rows(other, rows_);
 }
 
-S21Matrix::S21Matrix(S21Matrix &&other)
-    : rows_(other.rows_), cols_(other.cols_), matrix_(other.matrix_) {
+template <typename Scalar>
+S21BasicMatrix<Scalar>::S21BasicMatrix(S21BasicMatrix &&other) noexcept
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      ld_(other.ld_),
+      row_capacity_(other.row_capacity_),
+      matrix_(other.matrix_),
+      factors_(std::move(other.factors_)) {
   other.matrix_ = nullptr;
-  other.rows_ = other.cols_ = 0;
+  other.rows_ = other.cols_ = other.ld_ = other.row_capacity_ = 0;
+}
+
+template <typename Scalar>
+S21BasicMatrix<Scalar>::S21BasicMatrix(const S21BasicMatrixView<Scalar> &view)
+    : rows_(view.GetRows()), cols_(view.GetCols()) {
+  S21_INSTRUMENT_OP(kCopy, 0);
+  create_matrix();
+  S21_INSTRUMENT_COPY(std::uint64_t(rows_) * cols_);
+  for (int i = 0; i < rows_; i++) {
+    Scalar *out = row(i);
+    for (int j = 0; j < cols_; j++) out[j] = *view.at(i, j);
+  }
 }
 
-S21Matrix::~S21Matrix() { remove_matrix(); }
+template <typename Scalar>
+S21BasicMatrix<Scalar>::~S21BasicMatrix() { remove_matrix(); }
 
 /** GETTERS AND SETTERS **/
-int S21Matrix::GetRows() { return rows_; }
+template <typename Scalar>
+int S21BasicMatrix<Scalar>::GetRows() const { return rows_; }
 
-int S21Matrix::GetCols() { return cols_; }
+template <typename Scalar>
+int S21BasicMatrix<Scalar>::GetCols() const { return cols_; }
 
-void S21Matrix::SetRows(int rows) {
+template <typename Scalar>
+void S21BasicMatrix<Scalar>::SetRows(int rows) {
   if (rows_ != rows) {
-    S21Matrix tmp(rows, cols_);
-    int tmp_rows = 0;
-    if (rows < rows_)
-      tmp_rows = rows;
-    else
-      tmp_rows = rows_;
-    for (int i = 0; i < tmp_rows; i++) {
-      for (int j = 0; j < cols_; j++) {
-        tmp.matrix_[i][j] = matrix_[i][j];
-      }
+    if (rows < 1 || cols_ < 1) {
+      throw std::out_of_range("Incorrect matrix size");
+    }
+    invalidate_factors();
+    if (rows > row_capacity_) {
+      Reserve(std::max(rows, 2 * row_capacity_), cols_);
     }
-    *this = tmp;
+    // Rows left over from an earlier shrink still hold their old values.
+    for (int i = rows_; i < rows; i++) std::fill_n(row(i), cols_, Scalar(0));
+    rows_ = rows;
   }
 }
 
-void S21Matrix::SetCols(int cols) {
+template <typename Scalar>
+void S21BasicMatrix<Scalar>::SetCols(int cols) {
   if (cols_ != cols) {
-    S21Matrix tmp(rows_, cols);
-    int tmp_cols = 0;
-    if (cols < cols_)
-      tmp_cols = cols;
-    else
-      tmp_cols = cols_;
-    for (int i = 0; i < rows_; i++) {
-      for (int j = 0; j < tmp_cols; j++) {
-        tmp.matrix_[i][j] = matrix_[i][j];
-      }
+    if (rows_ < 1 || cols < 1) {
+      throw std::out_of_range("Incorrect matrix size");
     }
-    *this = tmp;
+    invalidate_factors();
+    if (cols > ld_) Reserve(rows_, std::max(cols, 2 * ld_));
+    for (int i = 0; i < rows_ && cols > cols_; i++) {
+      std::fill(row(i) + cols_, row(i) + cols, Scalar(0));
+    }
+    cols_ = cols;
+  }
+}
+
+/*
+ * The new buffer is zeroed like a fresh one and takes the rows_ x cols_
+ * elements over; its leading dimension is rounded up to an aligned stride
+ * again. The cached factors describe the same elements and are kept.
+ */
+template <typename Scalar>
+void S21BasicMatrix<Scalar>::Reserve(int rows, int cols) {
+  if (rows < 1 || cols < 1) {
+    throw std::out_of_range("Incorrect matrix size");
+  }
+  if (rows <= row_capacity_ && cols <= ld_) return;
+  const int capacity = std::max(rows, row_capacity_);
+  const int ld = leading_dimension(std::max(cols, ld_));
+  const std::size_t count = std::size_t(capacity) * ld;
+  Scalar *data = allocate(count);
+  std::fill_n(data, count, Scalar(0));
+  S21_INSTRUMENT_COPY(std::uint64_t(rows_) * cols_);
+  for (int i = 0; i < rows_; i++) {
+    std::copy_n(row(i), cols_, data + std::ptrdiff_t(i) * ld);
   }
+  if (matrix_ != nullptr) deallocate(matrix_);
+  matrix_ = data;
+  ld_ = ld;
+  row_capacity_ = capacity;
 }
 
 /** MATRIX FUNCTIONS */
-bool S21Matrix::EqMatrix(const S21Matrix &other) {
+template <typename Scalar>
+bool S21BasicMatrix<Scalar>::EqMatrix(const S21BasicMatrix &other) {
+  S21_INSTRUMENT_OP(kEq, double(rows_) * cols_);
   bool flag = true;
   if (rows_ == other.rows_ && cols_ == other.cols_) {
-    for (int i = 0; i < rows_; i++) {
-      for (int j = 0; (j < cols_) && flag; j++) {
-        if (fabs(matrix_[i][j] - other.matrix_[i][j]) > 1e-7) {
-          flag = false;
-          break;
-        }
-      }
+    const s21::ElementwiseKernels<Scalar> &kernels = s21::Kernels<Scalar>();
+    for (int i = 0; i < rows_ && flag; i++) {
+      flag = kernels.near(row(i), other.row(i), cols_,
+                          s21::kEqTolerance<Scalar>);
     }
   } else {
     flag = false;
@@ -85,244 +235,1087 @@ bool S21Matrix::EqMatrix(const S21Matrix &other) {
   return flag;
 }
 
-void S21Matrix::SumMatrix(const S21Matrix &other) {
+template <typename Scalar>
+void S21BasicMatrix<Scalar>::SumMatrix(const S21BasicMatrix &other) {
+  S21_INSTRUMENT_OP(kSum, double(rows_) * cols_);
   check_for_sum_sub(rows_, cols_, other.rows_, other.cols_);
+  invalidate_factors();
+  const s21::ElementwiseKernels<Scalar> &kernels = s21::Kernels<Scalar>();
   for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      matrix_[i][j] += other.matrix_[i][j];
-    }
+    kernels.add(row(i), other.row(i), cols_);
   }
 }
 
-void S21Matrix::SubMatrix(const S21Matrix &other) {
+template <typename Scalar>
+void S21BasicMatrix<Scalar>::SubMatrix(const S21BasicMatrix &other) {
+  S21_INSTRUMENT_OP(kSub, double(rows_) * cols_);
   check_for_sum_sub(rows_, cols_, other.rows_, other.cols_);
+  invalidate_factors();
+  const s21::ElementwiseKernels<Scalar> &kernels = s21::Kernels<Scalar>();
   for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      matrix_[i][j] -= other.matrix_[i][j];
-    }
+    kernels.sub(row(i), other.row(i), cols_);
   }
 }
 
-void S21Matrix::MulNumber(const double num) {
+template <typename Scalar>
+void S21BasicMatrix<Scalar>::MulNumber(const Scalar num) {
+  S21_INSTRUMENT_OP(kMulNumber, double(rows_) * cols_);
+  invalidate_factors();
+  const s21::ElementwiseKernels<Scalar> &kernels = s21::Kernels<Scalar>();
   for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      matrix_[i][j] *= num;
-    }
+    kernels.scale(row(i), num, cols_);
   }
 }
 
-void S21Matrix::MulMatrix(const S21Matrix &other) {
+template <typename Scalar>
+void S21BasicMatrix<Scalar>::MulMatrix(const S21BasicMatrix &other) {
   check_rows_cols(cols_, other.rows_);
-  S21Matrix tmp(rows_, other.cols_);
+  S21_INSTRUMENT_OP(kMulMatrix, 2.0 * rows_ * other.cols_ * cols_);
+  S21BasicMatrix tmp(rows_, other.cols_);
+  s21::Gemm(rows_, other.cols_, cols_, Scalar(1), matrix_, ld_, 1,
+            other.matrix_, other.ld_, 1, Scalar(0), tmp.matrix_, tmp.ld_);
+  swap(tmp);
+}
+
+template <typename Scalar>
+void S21BasicMatrix<Scalar>::MulMatrix(const S21BasicMatrix &other,
+                                       S21MulPolicy policy) {
+  if (policy == S21MulPolicy::kClassic) return MulMatrix(other);
+  check_rows_cols(cols_, other.rows_);
+  S21_INSTRUMENT_OP(kMulMatrix, 2.0 * rows_ * other.cols_ * cols_);
+  S21BasicMatrix tmp(rows_, other.cols_);
+  s21::StrassenGemm(rows_, other.cols_, cols_, matrix_, ld_, other.matrix_,
+                    other.ld_, tmp.matrix_, tmp.ld_);
+  swap(tmp);
+}
+
+template <typename Scalar>
+S21BasicMatrix<Scalar> S21BasicMatrix<Scalar>::Transpose() {
+  S21_INSTRUMENT_OP(kTranspose, 0);
+  S21BasicMatrix tmp(cols_, rows_);
+  s21::Transpose(rows_, cols_, matrix_, ld_, tmp.matrix_, tmp.ld_);
+  return tmp;
+}
+
+/*
+ * Square matrices swap mirrored tiles. Other shapes are packed densely and
+ * permuted along cycles, which leaves ld_ equal to the new cols_ instead of
+ * a padded value; no second buffer is allocated either way.
+ */
+template <typename Scalar>
+void S21BasicMatrix<Scalar>::TransposeInPlace() {
+  S21_INSTRUMENT_OP(kTranspose, 0);
+  invalidate_factors();
+  if (rows_ == cols_) {
+    s21::TransposeSquareInPlace(rows_, matrix_, ld_);
+    return;
+  }
+  const std::size_t count = std::size_t(row_capacity_) * ld_;
+  for (int i = 1; i < rows_ && ld_ != cols_; i++) {
+    std::memmove(matrix_ + std::ptrdiff_t(i) * cols_, row(i),
+                 sizeof(Scalar) * cols_);
+  }
+  s21::TransposeDenseInPlace(rows_, cols_, matrix_);
+  std::swap(rows_, cols_);
+  ld_ = cols_;
+  row_capacity_ = int(count / ld_);
+}
+
+template <typename Scalar>
+S21BasicMatrixView<Scalar> S21BasicMatrix<Scalar>::T() const {
+  return S21BasicMatrixView<Scalar>(*this).T();
+}
+
+template <typename Scalar>
+S21BasicMatrixView<Scalar> S21BasicMatrix<Scalar>::Slice(int row, int col,
+                                                         int rows,
+                                                         int cols) const {
+  return S21BasicMatrixView<Scalar>(*this).Slice(row, col, rows, cols);
+}
+
+template <typename Scalar>
+bool S21BasicMatrix<Scalar>::EqMatrix(
+    const S21BasicMatrixView<Scalar> &other) {
+  S21_INSTRUMENT_OP(kEq, double(rows_) * cols_);
+  if (rows_ != other.GetRows() || cols_ != other.GetCols()) return false;
+  const s21::ElementwiseKernels<Scalar> &kernels = s21::Kernels<Scalar>();
+  const Scalar tolerance = s21::kEqTolerance<Scalar>;
   for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < other.cols_; j++) {
-      for (int k = 0; k < other.rows_; k++) {
-        tmp.matrix_[i][j] += matrix_[i][k] * other.matrix_[k][j];
+    const Scalar *a = row(i);
+    if (other.GetColStride() == 1) {
+      if (!kernels.near(a, other.at(i, 0), cols_, tolerance)) return false;
+    } else {
+      for (int j = 0; j < cols_; j++) {
+        if (std::abs(a[j] - *other.at(i, j)) > tolerance) return false;
       }
     }
   }
-  *this = tmp;
+  return true;
 }
 
-S21Matrix S21Matrix::Transpose() {
-  S21Matrix tmp(cols_, rows_);
+template <typename Scalar>
+void S21BasicMatrix<Scalar>::SumMatrix(
+    const S21BasicMatrixView<Scalar> &other) {
+  S21_INSTRUMENT_OP(kSum, double(rows_) * cols_);
+  check_for_sum_sub(rows_, cols_, other.GetRows(), other.GetCols());
+  if (aliases(other)) {
+    SumMatrix(S21BasicMatrix(other));
+    return;
+  }
+  invalidate_factors();
+  const s21::ElementwiseKernels<Scalar> &kernels = s21::Kernels<Scalar>();
   for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      tmp.matrix_[j][i] = matrix_[i][j];
+    Scalar *a = row(i);
+    if (other.GetColStride() == 1) {
+      kernels.add(a, other.at(i, 0), cols_);
+    } else {
+      for (int j = 0; j < cols_; j++) a[j] += *other.at(i, j);
     }
   }
-  return tmp;
 }
 
-S21Matrix S21Matrix::CalcComplements() {
+template <typename Scalar>
+void S21BasicMatrix<Scalar>::SubMatrix(
+    const S21BasicMatrixView<Scalar> &other) {
+  S21_INSTRUMENT_OP(kSub, double(rows_) * cols_);
+  check_for_sum_sub(rows_, cols_, other.GetRows(), other.GetCols());
+  if (aliases(other)) {
+    SubMatrix(S21BasicMatrix(other));
+    return;
+  }
+  invalidate_factors();
+  const s21::ElementwiseKernels<Scalar> &kernels = s21::Kernels<Scalar>();
+  for (int i = 0; i < rows_; i++) {
+    Scalar *a = row(i);
+    if (other.GetColStride() == 1) {
+      kernels.sub(a, other.at(i, 0), cols_);
+    } else {
+      for (int j = 0; j < cols_; j++) a[j] -= *other.at(i, j);
+    }
+  }
+}
+
+template <typename Scalar>
+void S21BasicMatrix<Scalar>::MulMatrix(
+    const S21BasicMatrixView<Scalar> &other) {
+  check_rows_cols(cols_, other.GetRows());
+  S21_INSTRUMENT_OP(kMulMatrix, 2.0 * rows_ * other.GetCols() * cols_);
+  S21BasicMatrix tmp(rows_, other.GetCols());
+  s21::Gemm(rows_, other.GetCols(), cols_, Scalar(1), matrix_, ld_, 1,
+            other.Data(), other.GetRowStride(), other.GetColStride(), Scalar(0),
+            tmp.matrix_, tmp.ld_);
+  swap(tmp);
+}
+
+template <typename Scalar>
+void S21BasicMatrix<Scalar>::Gemm(Scalar alpha,
+                                  const S21BasicMatrixView<Scalar> &a,
+                                  const S21BasicMatrixView<Scalar> &b,
+                                  Scalar beta) {
+  check_rows_cols(a.GetCols(), b.GetRows());
+  check_for_sum_sub(rows_, cols_, a.GetRows(), b.GetCols());
+  if (aliases(a)) {
+    Gemm(alpha, S21BasicMatrix(a), b, beta);
+    return;
+  }
+  if (aliases(b)) {
+    Gemm(alpha, a, S21BasicMatrix(b), beta);
+    return;
+  }
+  S21_INSTRUMENT_OP(kMulMatrix, 2.0 * rows_ * cols_ * a.GetCols());
+  invalidate_factors();
+  s21::Gemm(rows_, cols_, a.GetCols(), alpha, a.Data(), a.GetRowStride(),
+            a.GetColStride(), b.Data(), b.GetRowStride(), b.GetColStride(),
+            beta, matrix_, ld_);
+}
+
+template <typename Scalar>
+S21BasicMatrix<Scalar> S21BasicMatrix<Scalar>::CalcComplements() {
   check_rows_cols(rows_, cols_);
-  S21Matrix result(rows_, cols_);
+  S21_INSTRUMENT_OP(kComplements, 8.0 / 3 * rows_ * rows_ * rows_);
+  S21BasicMatrix result(rows_, cols_);
   if (rows_ == 1) {
-    result.matrix_[0][0] = matrix_[0][0];
+    result.matrix_[0] = matrix_[0];
+  } else if (rows_ > 3) {
+    complements_from_factors(result);
   } else {
+    // Reference path: one determinant per minor, cheap at these sizes.
     this->minor_matrix(result);
     for (int i = 0; i < result.rows_; i++) {
       for (int j = 0; j < result.cols_; j++) {
-        result.matrix_[i][j] *= pow(-1, i + j);
+        if ((i + j) % 2) result.row(i)[j] = -result.row(i)[j];
       }
     }
   }
   return result;
 }
 
-double S21Matrix::Determinant() {
+template <typename Scalar>
+Scalar S21BasicMatrix<Scalar>::Determinant() {
+  return Determinant(S21Factorization::kAuto);
+}
+
+template <typename Scalar>
+Scalar S21BasicMatrix<Scalar>::Determinant(S21Factorization hint) {
   check_rows_cols(rows_, cols_);
-  double determ = 0;
-  double multiplier = 1;
+  S21_INSTRUMENT_OP(kDeterminant,
+                    factors_ ? 0.0 : 2.0 / 3 * rows_ * rows_ * rows_);
+  Scalar determ = 0;
   if (rows_ == 1) {
-    determ = matrix_[0][0];
+    determ = matrix_[0];
   } else if (rows_ == 2) {
-    determ = (matrix_[0][0] * matrix_[1][1] - matrix_[0][1] * matrix_[1][0]);
+    const Scalar *r0 = row(0);
+    const Scalar *r1 = row(1);
+    determ = (r0[0] * r1[1] - r0[1] * r1[0]);
   } else {
-    S21Matrix tmp((rows_ - 1), (cols_ - 1));
+    const Factors &cached = factors(hint);
+    determ = 1;
     for (int i = 0; i < rows_; i++) {
-      this->del_rc(tmp, 0, i);
-      determ += multiplier * matrix_[0][i] * tmp.Determinant();
-      multiplier *= -1;
+      determ *= cached.factor.row(i)[i];
+    }
+    if (cached.cholesky) {
+      determ *= determ;
+    } else {
+      for (int i = 0; i < rows_; i++) {
+        if (cached.pivot[i] != i) determ = -determ;
+      }
     }
+    // A pivot that is rounding noise next to its own row reports an exact
+    // zero, not the residue; badly scaled rows keep their true product.
+    if (cached.singular) determ = 0;
   }
   return determ;
 }
 
-S21Matrix S21Matrix::InverseMatrix() {
+/*
+ * Returns the packed factors of P * A = L * U: the strictly lower part holds
+ * L (unit diagonal implied), the upper part holds U. Row i was swapped with
+ * row pivot[i] at step i.
+ */
+template <typename Scalar>
+S21BasicMatrix<Scalar> S21BasicMatrix<Scalar>::LU(
+    std::vector<int> &pivot) const {
+  check_rows_cols(rows_, cols_);
+  if (factors_ && !factors_->cholesky) {
+    pivot = factors_->pivot;
+    return factors_->factor;
+  }
+  S21BasicMatrix lu(*this);
+  pivot.resize(rows_);
+  lu_factor(lu.matrix_, rows_, lu.ld_, pivot.data());
+  return lu;
+}
+
+template <typename Scalar>
+S21BasicMatrix<Scalar> S21BasicMatrix<Scalar>::Cholesky() const {
   check_rows_cols(rows_, cols_);
-  double det = 0;
-  det = this->Determinant();
-  if (!det) throw std::out_of_range("Determinant must not be zero");
-  S21Matrix matrix1(rows_, cols_);
-  if (fabs(det) > 1e-7) {
-    matrix1 = this->CalcComplements();
-    matrix1 = matrix1.Transpose();
-    matrix1.MulNumber((double)1.0 / det);
+  if (factors_ && factors_->cholesky) return factors_->factor;
+  S21BasicMatrix factor(*this);
+  if (!cholesky_factor(factor.matrix_, rows_, factor.ld_)) {
+    throw std::out_of_range("Matrix must be positive definite");
   }
-  return matrix1;
+  return factor;
+}
+
+// Compares mirrored tiles, so both reads of a pair stay in cache.
+template <typename Scalar>
+bool S21BasicMatrix<Scalar>::IsSymmetric(Scalar tolerance) const {
+  constexpr int kTile = 32;
+  if (rows_ != cols_) return false;
+  for (int i0 = 0; i0 < rows_; i0 += kTile) {
+    const int i1 = std::min(i0 + kTile, rows_);
+    for (int j0 = 0; j0 <= i0; j0 += kTile) {
+      const int j1 = std::min(j0 + kTile, rows_);
+      for (int i = i0; i < i1; i++) {
+        const Scalar *ri = row(i);
+        for (int j = j0; j < std::min(j1, i); j++) {
+          if (!(std::abs(ri[j] - row(j)[i]) <= tolerance)) return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+template <typename Scalar>
+S21BasicMatrix<Scalar> S21BasicMatrix<Scalar>::InverseMatrix() {
+  return InverseMatrix(S21Factorization::kAuto);
+}
+
+template <typename Scalar>
+S21BasicMatrix<Scalar> S21BasicMatrix<Scalar>::InverseMatrix(
+    S21Factorization hint) {
+  check_rows_cols(rows_, cols_);
+  S21_INSTRUMENT_OP(kInverse, factors_ && factors_->inverse.matrix_
+                                  ? 0.0
+                                  : 2.0 * rows_ * rows_ * rows_);
+  Factors &cached = factors(hint);
+  if (cached.singular) {
+    throw std::out_of_range("Determinant must not be zero");
+  }
+  if (cached.inverse.matrix_ == nullptr) {
+    if (cached.cholesky) {
+      S21BasicMatrix work(cached.factor);
+      S21BasicMatrix inverse(rows_, cols_);
+      cholesky_inverse(work.matrix_, rows_, work.ld_, inverse.matrix_,
+                       inverse.ld_);
+      cached.inverse = std::move(inverse);
+    } else {
+      cached.inverse = cached.factor;
+      lu_inverse(cached.inverse.matrix_, rows_, cached.inverse.ld_,
+                 cached.pivot.data());
+    }
+  }
+  return cached.inverse;
+}
+
+template <typename Scalar>
+S21BasicMatrix<Scalar> S21BasicMatrix<Scalar>::Solve(
+    const S21BasicMatrix &other) {
+  return Solve(other, S21Factorization::kAuto);
+}
+
+template <typename Scalar>
+S21BasicMatrix<Scalar> S21BasicMatrix<Scalar>::Solve(
+    const S21BasicMatrix &other, S21Factorization hint) {
+  check_rows_cols(rows_, cols_);
+  check_rows_cols(rows_, other.rows_);
+  S21_INSTRUMENT_OP(kSolve, (factors_ ? 0.0 : 2.0 / 3 * rows_ * rows_ * rows_) +
+                                2.0 * rows_ * rows_ * other.cols_);
+  const Factors &cached = factors(hint);
+  if (cached.singular) {
+    throw std::out_of_range("Determinant must not be zero");
+  }
+  S21BasicMatrix result(other);
+  const S21BasicMatrix &factor = cached.factor;
+  if (cached.cholesky) {
+    cholesky_solve(factor.matrix_, rows_, factor.ld_, result.matrix_,
+                   result.cols_, result.ld_);
+  } else {
+    lu_solve(factor.matrix_, rows_, factor.ld_, cached.pivot.data(),
+             result.matrix_, result.cols_, result.ld_);
+  }
+  return result;
+}
+
+template <typename Scalar>
+void S21BasicMatrix<Scalar>::SetGemmBlocking(int mc, int kc, int nc) {
+  s21::SetGemmBlocking({mc, kc, nc});
+}
+
+template <typename Scalar>
+void S21BasicMatrix<Scalar>::SetThreadCount(int count) {
+  s21::ThreadPool::Instance().SetThreadCount(count);
+}
+
+template <typename Scalar>
+void S21BasicMatrix<Scalar>::SetStrassenCutoff(int cutoff) {
+  s21::SetStrassenCutoff(cutoff);
+}
+
+template <typename Scalar>
+int S21BasicMatrix<Scalar>::TuneStrassenCutoff() {
+  return s21::TuneStrassenCutoff();
 }
 
 /** OVERLOAD OPERATORS **/
-S21Matrix S21Matrix::operator+(const S21Matrix &other) {
-  S21Matrix result(other.rows_, other.cols_);
-  result.SumMatrix(*this);
+template <typename Scalar>
+S21BasicMatrix<Scalar> S21BasicMatrix<Scalar>::operator+(
+    const S21BasicMatrix &other) const & {
+  S21BasicMatrix result(*this);
   result.SumMatrix(other);
   return result;
 }
 
-S21Matrix S21Matrix::operator-(const S21Matrix &other) {
-  S21Matrix result(*this);
+template <typename Scalar>
+S21BasicMatrix<Scalar> S21BasicMatrix<Scalar>::operator+(
+    const S21BasicMatrix &other) && {
+  SumMatrix(other);
+  return std::move(*this);
+}
+
+template <typename Scalar>
+S21BasicMatrix<Scalar> S21BasicMatrix<Scalar>::operator+(
+    S21BasicMatrix &&other) const & {
+  other.SumMatrix(*this);
+  return std::move(other);
+}
+
+template <typename Scalar>
+S21BasicMatrix<Scalar> S21BasicMatrix<Scalar>::operator+(
+    S21BasicMatrix &&other) && {
+  SumMatrix(other);
+  return std::move(*this);
+}
+
+template <typename Scalar>
+S21BasicMatrix<Scalar> S21BasicMatrix<Scalar>::operator-(
+    const S21BasicMatrix &other) const & {
+  S21BasicMatrix result(*this);
   result.SubMatrix(other);
   return result;
 }
 
-S21Matrix S21Matrix::operator*(const S21Matrix &other) {
-  S21Matrix result(*this);
-  result.MulMatrix(other);
+template <typename Scalar>
+S21BasicMatrix<Scalar> S21BasicMatrix<Scalar>::operator-(
+    const S21BasicMatrix &other) && {
+  SubMatrix(other);
+  return std::move(*this);
+}
+
+template <typename Scalar>
+S21BasicMatrix<Scalar> S21BasicMatrix<Scalar>::operator-(
+    S21BasicMatrix &&other) const & {
+  S21_INSTRUMENT_OP(kSub, double(rows_) * cols_);
+  check_for_sum_sub(rows_, cols_, other.rows_, other.cols_);
+  other.invalidate_factors();
+  const s21::ElementwiseKernels<Scalar> &kernels = s21::Kernels<Scalar>();
+  for (int i = 0; i < rows_; i++) {
+    kernels.rsub(other.row(i), row(i), cols_);
+  }
+  return std::move(other);
+}
+
+template <typename Scalar>
+S21BasicMatrix<Scalar> S21BasicMatrix<Scalar>::operator-(
+    S21BasicMatrix &&other) && {
+  SubMatrix(other);
+  return std::move(*this);
+}
+
+template <typename Scalar>
+S21BasicMatrix<Scalar> S21BasicMatrix<Scalar>::operator*(
+    const S21BasicMatrix &other) const & {
+  check_rows_cols(cols_, other.rows_);
+  S21_INSTRUMENT_OP(kMulMatrix, 2.0 * rows_ * other.cols_ * cols_);
+  S21BasicMatrix result(rows_, other.cols_);
+  s21::Gemm(rows_, other.cols_, cols_, Scalar(1), matrix_, ld_, 1,
+            other.matrix_, other.ld_, 1, Scalar(0), result.matrix_, result.ld_);
   return result;
 }
 
-S21Matrix S21Matrix::operator*(const double &num) {
-  S21Matrix result(*this);
+template <typename Scalar>
+S21BasicMatrix<Scalar> S21BasicMatrix<Scalar>::operator*(
+    const S21BasicMatrix &other) && {
+  MulMatrix(other);
+  return std::move(*this);
+}
+
+template <typename Scalar>
+S21BasicMatrix<Scalar> S21BasicMatrix<Scalar>::operator*(
+    const Scalar &num) const & {
+  S21BasicMatrix result(*this);
   result.MulNumber(num);
   return result;
 }
 
-bool S21Matrix::operator==(const S21Matrix &other) {
+template <typename Scalar>
+S21BasicMatrix<Scalar> S21BasicMatrix<Scalar>::operator*(const Scalar &num) && {
+  MulNumber(num);
+  return std::move(*this);
+}
+
+template <typename Scalar>
+bool S21BasicMatrix<Scalar>::operator==(const S21BasicMatrix &other) {
   return this->EqMatrix(other);
 }
 
-S21Matrix &S21Matrix::operator=(const S21Matrix &other) {
+template <typename Scalar>
+S21BasicMatrix<Scalar> &S21BasicMatrix<Scalar>::operator=(
+    const S21BasicMatrix &other) {
+  if (this == &other) return *this;
+  S21_INSTRUMENT_OP(kCopy, 0);
+  invalidate_factors();
   if (this->rows_ != other.rows_ || this->cols_ != other.cols_) {
     remove_matrix();
     rows_ = other.rows_;
     cols_ = other.cols_;
     create_matrix();
   }
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      matrix_[i][j] = other.matrix_[i][j];
-    }
+  copy_rows(other, rows_);
+  return *this;
+}
+
+template <typename Scalar>
+S21BasicMatrix<Scalar> &S21BasicMatrix<Scalar>::operator=(
+    S21BasicMatrix &&other) noexcept {
+  if (this != &other) {
+    remove_matrix();
+    swap(other);
   }
   return *this;
 }
 
-S21Matrix &S21Matrix::operator+=(const S21Matrix &other) {
+template <typename Scalar>
+S21BasicMatrix<Scalar> &S21BasicMatrix<Scalar>::operator+=(
+    const S21BasicMatrix &other) {
   this->SumMatrix(other);
   return *this;
 }
 
-S21Matrix &S21Matrix::operator-=(const S21Matrix &other) {
+template <typename Scalar>
+S21BasicMatrix<Scalar> &S21BasicMatrix<Scalar>::operator-=(
+    const S21BasicMatrix &other) {
   this->SubMatrix(other);
   return *this;
 }
 
-S21Matrix &S21Matrix::operator*=(const S21Matrix &other) {
+template <typename Scalar>
+S21BasicMatrix<Scalar> &S21BasicMatrix<Scalar>::operator*=(
+    const S21BasicMatrix &other) {
   this->MulMatrix(other);
   return *this;
 }
 
-S21Matrix &S21Matrix::operator*=(const double &num) {
+template <typename Scalar>
+S21BasicMatrix<Scalar> &S21BasicMatrix<Scalar>::operator*=(const Scalar &num) {
   this->MulNumber(num);
   return *this;
 }
 
-double &S21Matrix::operator()(const int row, const int col) {
+template <typename Scalar>
+Scalar &S21BasicMatrix<Scalar>::operator()(const int row, const int col) {
   if (rows_ <= row || cols_ <= col || row < 0 || col < 0) {
     throw std::out_of_range("Incorrect Index");
   }
-  return matrix_[row][col];
+  invalidate_factors();
+  return this->row(row)[col];
+}
+
+template <typename Scalar>
+const Scalar &S21BasicMatrix<Scalar>::operator()(
+    const int row, const int col) const {
+  if (rows_ <= row || cols_ <= col || row < 0 || col < 0) {
+    throw std::out_of_range("Incorrect Index");
+  }
+  return this->row(row)[col];
 }
 
 /** HELP FUNCTIONS **/
-void S21Matrix::create_matrix() {
+template <typename Scalar>
+void S21BasicMatrix<Scalar>::create_matrix() {
   if (rows_ < 1 || cols_ < 1) {
     throw std::out_of_range("Incorrect matrix size");
   }
-  int counter = 0;
-  matrix_ = new double *[rows_];
-  for (int i = 0; i < rows_; i++) {
-    try {
-      matrix_[i] = new double[cols_]();
-      counter++;
-    } catch (...) {
-      for (int i = 0; i < counter; i++) {
-        delete[] matrix_[i];
+  ld_ = leading_dimension(cols_);
+  row_capacity_ = rows_;
+  std::size_t count = std::size_t(rows_) * ld_;
+  matrix_ = allocate(count);
+  std::fill_n(matrix_, count, Scalar(0));
+}
+
+template <typename Scalar>
+void S21BasicMatrix<Scalar>::remove_matrix() {
+  if (matrix_ != nullptr) {
+    deallocate(matrix_);
+    matrix_ = nullptr;
+    rows_ = cols_ = ld_ = row_capacity_ = 0;
+  }
+  invalidate_factors();
+}
+
+template <typename Scalar>
+void S21BasicMatrix<Scalar>::swap(S21BasicMatrix &other) noexcept {
+  std::swap(rows_, other.rows_);
+  std::swap(cols_, other.cols_);
+  std::swap(ld_, other.ld_);
+  std::swap(row_capacity_, other.row_capacity_);
+  std::swap(matrix_, other.matrix_);
+  std::swap(factors_, other.factors_);
+}
+
+template <typename Scalar>
+typename S21BasicMatrix<Scalar>::Factors &S21BasicMatrix<Scalar>::factors(
+    S21Factorization hint) {
+  if (factors_) return *factors_;
+  std::unique_ptr<Factors> cached(new Factors);
+  cached->cholesky = false;
+  cached->singular = false;
+  if (hint == S21Factorization::kCholesky ||
+      (hint == S21Factorization::kAuto && IsSymmetric(0))) {
+    cached->factor = *this;
+    cached->cholesky =
+        cholesky_factor(cached->factor.matrix_, rows_, cached->factor.ld_);
+    if (!cached->cholesky && hint == S21Factorization::kCholesky) {
+      throw std::out_of_range("Matrix must be positive definite");
+    }
+    // l_ii^2 is the pivot LU without row swaps would find, so it gets the
+    // same test against its row.
+    const std::vector<Scalar> tolerance = row_tolerances(matrix_, rows_, ld_);
+    for (int i = 0; i < rows_ && cached->cholesky; i++) {
+      const Scalar l = cached->factor.row(i)[i];
+      if (l * l <= tolerance[i]) cached->singular = true;
+    }
+  }
+  if (!cached->cholesky) {
+    // Pivot i is measured against the row of A that ended up in row i.
+    std::vector<Scalar> tolerance = row_tolerances(matrix_, rows_, ld_);
+    cached->factor = LU(cached->pivot);
+    for (int i = 0; i < rows_; i++) {
+      std::swap(tolerance[i], tolerance[cached->pivot[i]]);
+      if (std::abs(cached->factor.row(i)[i]) <= tolerance[i]) {
+        cached->singular = true;
       }
-      delete[] matrix_;
-      matrix_ = nullptr;
-      throw;
     }
   }
+  factors_ = std::move(cached);
+  return *factors_;
 }
 
-void S21Matrix::remove_matrix() {
-  if (matrix_ != nullptr) {
-    for (int i = 0; i < rows_; i++) {
-      delete[] matrix_[i];
+template <typename Scalar>
+void S21BasicMatrix<Scalar>::invalidate_factors() {
+  factors_.reset();
+}
+
+// Copies the first rows rows of other, which has as many columns as this.
+template <typename Scalar>
+void S21BasicMatrix<Scalar>::copy_rows(const S21BasicMatrix &other, int rows) {
+  S21_INSTRUMENT_COPY(std::uint64_t(rows) * cols_);
+  if (ld_ == other.ld_) {
+    std::memcpy(matrix_, other.matrix_, sizeof(Scalar) * rows * ld_);
+  } else {
+    for (int i = 0; i < rows; i++) {
+      std::copy_n(other.row(i), cols_, row(i));
     }
-    delete[] matrix_;
-    matrix_ = nullptr;
-    rows_ = cols_ = 0;
   }
 }
 
-void S21Matrix::del_rc(S21Matrix &other, int num_i, int num_j) {
+template <typename Scalar>
+bool S21BasicMatrix<Scalar>::aliases(
+    const S21BasicMatrixView<Scalar> &view) const {
+  std::less<const Scalar *> less;
+  const Scalar *end = matrix_ + std::ptrdiff_t(rows_) * ld_;
+  return matrix_ != nullptr && !less(view.Data(), matrix_) &&
+         less(view.Data(), end);
+}
+
+template <typename Scalar>
+int S21BasicMatrix<Scalar>::leading_dimension(int cols) {
+  const int per_line = kAlignment / sizeof(Scalar);
+  return (cols + per_line - 1) / per_line * per_line;
+}
+
+#ifdef S21_MATRIX_INSTRUMENT
+// The byte count is kept one alignment unit in front of the elements so that
+// deallocate can report it without a field in every matrix.
+template <typename Scalar>
+Scalar *S21BasicMatrix<Scalar>::allocate(std::size_t count) {
+  const std::size_t bytes = count * sizeof(Scalar);
+  char *block = static_cast<char *>(
+      ::operator new(bytes + kAlignment, std::align_val_t(kAlignment)));
+  *reinterpret_cast<std::size_t *>(block) = bytes;
+  S21_INSTRUMENT_ALLOC(bytes);
+  return reinterpret_cast<Scalar *>(block + kAlignment);
+}
+
+template <typename Scalar>
+void S21BasicMatrix<Scalar>::deallocate(Scalar *data) {
+  char *block = reinterpret_cast<char *>(data) - kAlignment;
+  S21_INSTRUMENT_FREE(*reinterpret_cast<std::size_t *>(block));
+  ::operator delete(block, std::align_val_t(kAlignment));
+}
+#else
+template <typename Scalar>
+Scalar *S21BasicMatrix<Scalar>::allocate(std::size_t count) {
+  return static_cast<Scalar *>(
+      ::operator new(count * sizeof(Scalar), std::align_val_t(kAlignment)));
+}
+
+template <typename Scalar>
+void S21BasicMatrix<Scalar>::deallocate(Scalar *data) {
+  ::operator delete(data, std::align_val_t(kAlignment));
+}
+#endif
+
+/*
+ * Right-looking LU with partial pivoting on a row-major block, kLuBlock
+ * columns at a time. Each panel is factored with rank-1 updates confined to
+ * the panel, the block row to its right is solved against the panel's unit
+ * lower triangle, and the trailing matrix gets a single GEMM update. A zero
+ * pivot column is skipped, which leaves a zero on the diagonal of U.
+ */
+template <typename Scalar>
+void S21BasicMatrix<Scalar>::lu_factor(Scalar *a, int n, int ld, int *pivot) {
+  auto r = [&](int i) { return a + std::ptrdiff_t(i) * ld; };
+  for (int k0 = 0; k0 < n; k0 += kLuBlock) {
+    const int end = std::min(k0 + kLuBlock, n);
+    for (int k = k0; k < end; k++) {
+      Scalar *rk = r(k);
+      int p = k;
+      Scalar max = std::abs(rk[k]);
+      for (int i = k + 1; i < n; i++) {
+        Scalar v = std::abs(r(i)[k]);
+        if (v > max) {
+          max = v;
+          p = i;
+        }
+      }
+      pivot[k] = p;
+      if (p != k) std::swap_ranges(rk, rk + n, r(p));
+      if (max == 0) continue;
+      for (int i = k + 1; i < n; i++) {
+        Scalar *ri = r(i);
+        const Scalar l = ri[k] / rk[k];
+        ri[k] = l;
+        for (int j = k + 1; j < end; j++) {
+          ri[j] -= l * rk[j];
+        }
+      }
+    }
+    if (end == n) break;
+    for (int i = k0 + 1; i < end; i++) {
+      Scalar *ri = r(i);
+      for (int k = k0; k < i; k++) {
+        const Scalar l = ri[k];
+        const Scalar *rk = r(k);
+        for (int j = end; j < n; j++) ri[j] -= l * rk[j];
+      }
+    }
+    s21::Gemm(n - end, n - end, end - k0, Scalar(-1), r(end) + k0, ld, 1,
+              r(k0) + end, ld, 1, Scalar(1), r(end) + end, ld);
+  }
+}
+
+/*
+ * Turns the packed LU factors into inv(A) in place: inv(U) by row-wise back
+ * substitution, then inv(A) * L = inv(U) solved column by column from the
+ * right, then the row pivots applied to the columns in reverse order.
+ */
+template <typename Scalar>
+void S21BasicMatrix<Scalar>::lu_inverse(Scalar *a, int n, int ld,
+                                        const int *pivot) {
+  std::vector<Scalar> work(n);
+  for (int i = n - 1; i >= 0; i--) {
+    Scalar *ri = a + std::ptrdiff_t(i) * ld;
+    std::fill(work.begin() + i, work.end(), Scalar(0));
+    for (int k = i + 1; k < n; k++) {
+      const Scalar u = ri[k];
+      const Scalar *rk = a + std::ptrdiff_t(k) * ld;
+      for (int j = k; j < n; j++) {
+        work[j] += u * rk[j];
+      }
+    }
+    ri[i] = Scalar(1) / ri[i];
+    for (int j = i + 1; j < n; j++) {
+      ri[j] = -work[j] * ri[i];
+    }
+  }
+  for (int j = n - 2; j >= 0; j--) {
+    for (int k = j + 1; k < n; k++) {
+      Scalar *rk = a + std::ptrdiff_t(k) * ld;
+      work[k] = rk[j];
+      rk[j] = 0;
+    }
+    for (int i = 0; i < n; i++) {
+      Scalar *ri = a + std::ptrdiff_t(i) * ld;
+      Scalar sum = 0;
+      for (int k = j + 1; k < n; k++) {
+        sum += ri[k] * work[k];
+      }
+      ri[j] -= sum;
+    }
+  }
+  for (int j = n - 2; j >= 0; j--) {
+    if (pivot[j] == j) continue;
+    for (int i = 0; i < n; i++) {
+      Scalar *ri = a + std::ptrdiff_t(i) * ld;
+      std::swap(ri[j], ri[pivot[j]]);
+    }
+  }
+}
+
+/*
+ * Overwrites the n x cols block b with inv(A) * b, given the packed factors
+ * of A from lu_factor: the row pivots first, then L * y = P * b and
+ * U * x = y.
+ */
+template <typename Scalar>
+void S21BasicMatrix<Scalar>::lu_solve(const Scalar *a, int n, int ld,
+                                      const int *pivot, Scalar *b, int cols,
+                                      int ldb) {
+  for (int k = 0; k < n; k++) {
+    if (pivot[k] != k) {
+      std::swap_ranges(b + std::ptrdiff_t(k) * ldb,
+                       b + std::ptrdiff_t(k) * ldb + cols,
+                       b + std::ptrdiff_t(pivot[k]) * ldb);
+    }
+  }
+  ForPanels(cols, [&](int j0, int width) {
+    LowerSolve(n, a, ld, 1, true, b + j0, width, ldb);
+    UpperSolve(n, a, ld, 1, false, b + j0, width, ldb);
+  });
+}
+
+/*
+ * Blocked right-looking Cholesky, A = L * L^T, reading the lower triangle of
+ * a and leaving L there with the strictly upper part zeroed. Per block
+ * column: the diagonal block is factored by dot products along rows, the
+ * rows below it are solved against it, and the trailing lower triangle is
+ * updated one block row at a time by GEMM, so about n^3 / 3 multiply-adds
+ * in all. Rows of the panel and block rows of the update are spread over
+ * the thread pool. Returns false, with a partly overwritten, as soon as a
+ * pivot is not positive.
+ */
+template <typename Scalar>
+bool S21BasicMatrix<Scalar>::cholesky_factor(Scalar *a, int n, int ld) {
+  auto r = [&](int i) { return a + std::ptrdiff_t(i) * ld; };
+  auto dot = [](const Scalar *x, const Scalar *y, int count) {
+    Scalar sum = 0;
+    for (int k = 0; k < count; k++) sum += x[k] * y[k];
+    return sum;
+  };
+  for (int k0 = 0; k0 < n; k0 += kLuBlock) {
+    const int end = std::min(k0 + kLuBlock, n);
+    for (int j = k0; j < end; j++) {
+      Scalar *rj = r(j);
+      const Scalar d = rj[j] - dot(rj + k0, rj + k0, j - k0);
+      if (!(d > 0)) return false;
+      rj[j] = std::sqrt(d);
+      for (int i = j + 1; i < end; i++) {
+        Scalar *ri = r(i);
+        ri[j] = (ri[j] - dot(ri + k0, rj + k0, j - k0)) / rj[j];
+      }
+    }
+    if (end == n) break;
+    const int blocks = (n - end + kLuBlock - 1) / kLuBlock;
+    s21::ThreadPool::Instance().ParallelFor(blocks, [&](int block) {
+      const int i0 = end + block * kLuBlock;
+      for (int i = i0; i < std::min(i0 + kLuBlock, n); i++) {
+        Scalar *ri = r(i);
+        for (int j = k0; j < end; j++) {
+          const Scalar *rj = r(j);
+          ri[j] = (ri[j] - dot(ri + k0, rj + k0, j - k0)) / rj[j];
+        }
+      }
+    });
+    s21::ThreadPool::Instance().ParallelFor(blocks, [&](int block) {
+      const int i0 = end + block * kLuBlock;
+      const int i1 = std::min(i0 + kLuBlock, n);
+      s21::Gemm(i1 - i0, i1 - end, end - k0, Scalar(-1), r(i0) + k0, ld, 1,
+                r(end) + k0, 1, ld, Scalar(1), r(i0) + end, ld);
+    });
+  }
+  for (int i = 0; i < n; i++) std::fill(r(i) + i + 1, r(i) + n, Scalar(0));
+  return true;
+}
+
+/*
+ * inv(A) = inv(L)^T * inv(L) into out. l is overwritten by inv(L), built row
+ * by row from the rows above it. Block row i0 of the lower triangle of the
+ * product only needs rows i0 .. n - 1 of inv(L), which keeps the GEMMs at
+ * about n^3 / 3 multiply-adds; the upper triangle is mirrored from it.
+ */
+template <typename Scalar>
+void S21BasicMatrix<Scalar>::cholesky_inverse(Scalar *l, int n, int ld,
+                                              Scalar *out, int ldo) {
+  auto r = [&](int i) { return l + std::ptrdiff_t(i) * ld; };
+  std::vector<Scalar> work(n);
+  for (int i = 0; i < n; i++) {
+    Scalar *ri = r(i);
+    std::fill(work.begin(), work.begin() + i, Scalar(0));
+    for (int k = 0; k < i; k++) {
+      const Scalar v = ri[k];
+      const Scalar *rk = r(k);
+      for (int j = 0; j <= k; j++) work[j] += v * rk[j];
+    }
+    const Scalar inverse = Scalar(1) / ri[i];
+    for (int j = 0; j < i; j++) ri[j] = -work[j] * inverse;
+    ri[i] = inverse;
+  }
+  const int blocks = (n + kLuBlock - 1) / kLuBlock;
+  s21::ThreadPool::Instance().ParallelFor(blocks, [&](int block) {
+    const int i0 = block * kLuBlock;
+    const int i1 = std::min(i0 + kLuBlock, n);
+    s21::Gemm(i1 - i0, i1, n - i0, Scalar(1), r(i0) + i0, 1, ld, r(i0), ld, 1,
+              Scalar(0), out + std::ptrdiff_t(i0) * ldo, ldo);
+  });
+  for (int i = 0; i < n; i++) {
+    for (int j = i + 1; j < n; j++) {
+      out[std::ptrdiff_t(i) * ldo + j] = out[std::ptrdiff_t(j) * ldo + i];
+    }
+  }
+}
+
+// Overwrites b with inv(A) * b from the Cholesky factor: L * y = b, then
+// L^T * x = y with L^T read through swapped strides.
+template <typename Scalar>
+void S21BasicMatrix<Scalar>::cholesky_solve(const Scalar *l, int n, int ld,
+                                            Scalar *b, int cols, int ldb) {
+  ForPanels(cols, [&](int j0, int width) {
+    LowerSolve(n, l, ld, 1, false, b + j0, width, ldb);
+    UpperSolve(n, l, 1, ld, false, b + j0, width, ldb);
+  });
+}
+
+// n * eps * max|a_ij| over each row i. A pivot at or below the tolerance of
+// the row it came from is rounding noise of a zero, while one that is only
+// small next to other rows is not: scaling a row scales its pivot too.
+template <typename Scalar>
+std::vector<Scalar> S21BasicMatrix<Scalar>::row_tolerances(const Scalar *a,
+                                                           int n, int ld) {
+  std::vector<Scalar> tolerance(n);
+  for (int i = 0; i < n; i++) {
+    const Scalar *ri = a + std::ptrdiff_t(i) * ld;
+    Scalar scale = 0;
+    for (int j = 0; j < n; j++) scale = std::max(scale, std::abs(ri[j]));
+    tolerance[i] = n * std::numeric_limits<Scalar>::epsilon() * scale;
+  }
+  return tolerance;
+}
+
+/*
+ * LU with complete pivoting, P * A * Q = L * U, stored like lu_factor. Step k
+ * swaps row k with row_pivot[k] and column k with col_pivot[k]. The pivot is
+ * the largest remaining element that is not rounding noise next to the row
+ * of A it sits in, by the row_tolerances test. Elimination stops once no
+ * such element is left; the number of completed steps, the numerical rank,
+ * is returned and the remaining block is left as is.
+ */
+template <typename Scalar>
+int S21BasicMatrix<Scalar>::lu_factor_full(Scalar *a, int n, int ld,
+                                           int *row_pivot, int *col_pivot) {
+  std::vector<Scalar> tolerance = row_tolerances(a, n, ld);
+  for (int k = 0; k < n; k++) {
+    int p = k, q = k;
+    Scalar max = 0;
+    for (int i = k; i < n; i++) {
+      const Scalar *ri = a + std::ptrdiff_t(i) * ld;
+      for (int j = k; j < n; j++) {
+        if (std::abs(ri[j]) > max && std::abs(ri[j]) > tolerance[i]) {
+          max = std::abs(ri[j]);
+          p = i;
+          q = j;
+        }
+      }
+    }
+    if (max == 0) return k;
+    row_pivot[k] = p;
+    col_pivot[k] = q;
+    Scalar *rk = a + std::ptrdiff_t(k) * ld;
+    std::swap(tolerance[k], tolerance[p]);
+    if (p != k) std::swap_ranges(rk, rk + n, a + std::ptrdiff_t(p) * ld);
+    if (q != k) {
+      for (int i = 0; i < n; i++) {
+        Scalar *ri = a + std::ptrdiff_t(i) * ld;
+        std::swap(ri[k], ri[q]);
+      }
+    }
+    for (int i = k + 1; i < n; i++) {
+      Scalar *ri = a + std::ptrdiff_t(i) * ld;
+      const Scalar l = ri[k] / rk[k];
+      ri[k] = l;
+      for (int j = k + 1; j < n; j++) {
+        ri[j] -= l * rk[j];
+      }
+    }
+  }
+  return n;
+}
+
+/*
+ * Cofactors in O(n^3) from P * A * Q = L * U. For a full-rank A the cofactor
+ * matrix is det(A) * inv(A)^T. At rank n - 1, adj(U) = det(U11) * x * e_n^T
+ * with U * x = 0 and x_n = 1, so the cofactors form the rank-1 matrix
+ * det(P) det(Q) det(U11) * (P^T w) (Q x)^T, where L^T w = e_n. Below that
+ * rank every cofactor is zero.
+ */
+template <typename Scalar>
+void S21BasicMatrix<Scalar>::complements_from_factors(
+    S21BasicMatrix &result) const {
+  const int n = rows_;
+  S21BasicMatrix lu(*this);
+  std::vector<int> row_pivot(n), col_pivot(n);
+  const int rank = lu_factor_full(lu.matrix_, n, lu.ld_, row_pivot.data(),
+                                  col_pivot.data());
+  if (rank < n - 1) return;
+  Scalar determ = 1;
+  for (int k = 0; k < rank; k++) {
+    if (row_pivot[k] != k) determ = -determ;
+    if (col_pivot[k] != k) determ = -determ;
+    determ *= lu.row(k)[k];
+  }
+  if (rank == n) {
+    lu_inverse(lu.matrix_, n, lu.ld_, row_pivot.data());
+    for (int k = n - 1; k >= 0; k--) {
+      if (col_pivot[k] != k) {
+        std::swap_ranges(lu.row(k), lu.row(k) + n, lu.row(col_pivot[k]));
+      }
+    }
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < n; j++) result.row(i)[j] = determ * lu.row(j)[i];
+    }
+    return;
+  }
+  std::vector<Scalar> x(n), w(n);
+  x[n - 1] = 1;
+  for (int i = n - 2; i >= 0; i--) {
+    const Scalar *ri = lu.row(i);
+    Scalar sum = ri[n - 1];
+    for (int j = i + 1; j < n - 1; j++) sum += ri[j] * x[j];
+    x[i] = -sum / ri[i];
+  }
+  w[n - 1] = 1;
+  for (int i = n - 2; i >= 0; i--) {
+    Scalar sum = 0;
+    for (int j = i + 1; j < n; j++) sum += lu.row(j)[i] * w[j];
+    w[i] = -sum;
+  }
+  for (int k = n - 2; k >= 0; k--) {
+    std::swap(x[k], x[col_pivot[k]]);
+    std::swap(w[k], w[row_pivot[k]]);
+  }
+  for (int i = 0; i < n; i++) {
+    Scalar *out = result.row(i);
+    for (int j = 0; j < n; j++) out[j] = determ * w[i] * x[j];
+  }
+}
+
+template <typename Scalar>
+void S21BasicMatrix<Scalar>::del_rc(S21BasicMatrix &other, int num_i,
+                                    int num_j) {
+  other.invalidate_factors();
   int i_row = 0;
   int i_col = 0;
   for (int i = 0; i < other.rows_; i++) {
     if (i == num_i) i_row = 1;
     for (int j = 0; j < other.cols_; j++) {
       if (j == num_j) i_col = 1;
-      other.matrix_[i][j] = matrix_[i + i_row][j + i_col];
+      other.row(i)[j] = row(i + i_row)[j + i_col];
     }
     i_col = 0;
   }
 }
 
-void S21Matrix::minor_matrix(S21Matrix &other) {
-  S21Matrix result(rows_, cols_);
-  S21Matrix minor(rows_ - 1, cols_ - 1);
+template <typename Scalar>
+void S21BasicMatrix<Scalar>::minor_matrix(S21BasicMatrix &other) {
+  S21BasicMatrix result(rows_, cols_);
+  S21BasicMatrix minor(rows_ - 1, cols_ - 1);
   for (int i = 0; i < rows_; i++) {
     for (int j = 0; j < cols_; j++) {
-      double determ = 0;
+      Scalar determ = 0;
       this->del_rc(minor, i, j);
       determ = minor.Determinant();
-      other.matrix_[i][j] = determ;
+      other.row(i)[j] = determ;
     }
   }
 }
 
-void S21Matrix::check_rows_cols(int rows, int cols) {
+template <typename Scalar>
+void S21BasicMatrix<Scalar>::check_rows_cols(int rows, int cols) {
   if (rows != cols) {
     throw std::out_of_range("rows and cols aren't equal");
   }
 }
 
-void S21Matrix::check_for_sum_sub(int rows1, int cols1, int rows2, int cols2) {
+template <typename Scalar>
+void S21BasicMatrix<Scalar>::check_for_sum_sub(int rows1, int cols1, int rows2,
+                                               int cols2) {
   if (rows1 != rows2 || cols1 != cols2) {
     throw std::out_of_range(
         "Incorrect input, matrices should have the same size");
   }
-}
\ No newline at end of file
+}
+
+template class S21BasicMatrix<float>;
+template class S21BasicMatrix<double>;
+template class S21BasicMatrix<long double>;
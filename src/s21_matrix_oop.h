@@ -2,52 +2,250 @@
 #define SRC_S21_MATRIX_OOP_H_
 
 #include <cmath>
+#include <cstddef>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "s21_matrix_file.h"
+#include "s21_matrix_view.h"
+
+template <typename E>
+class S21Expr;
+class S21MatrixRef;
+class S21SparseMatrix;
+class S21SymmetricMatrix;
+
+// kStrassen trades the element-wise error bound of the classic product for
+// fewer flops on large operands; see s21_strassen.h. Results are not
+// bit-identical between the two.
+enum class S21MulPolicy { kClassic, kStrassen };
+
+// How Determinant, InverseMatrix and Solve factor the matrix. kAuto tries
+// Cholesky on exactly symmetric matrices, IsSymmetric(0), and falls back to
+// LU when a pivot turns out not positive; kCholesky skips the check and
+// throws unless the matrix is positive definite. Cholesky reads only the
+// lower triangle. Both paths call a matrix singular when a pivot is rounding
+// noise next to its row of A, but the pivots differ, so on nearly singular
+// input the hint can decide which side of that line a matrix falls. The
+// hint applies when factors are computed, cached ones are reused as is.
+enum class S21Factorization { kAuto, kLU, kCholesky };
+
+namespace s21 {
+
+// Largest element difference EqMatrix accepts. The double value predates the
+// other element types; theirs scale it by the square root of the ratio of
+// machine epsilons, so each keeps about half its significant digits.
+template <typename Scalar>
+constexpr Scalar kEqTolerance = Scalar(1e-7);
+template <>
+constexpr float kEqTolerance<float> = 1e-3f;
+template <>
+constexpr long double kEqTolerance<long double> = 1e-9L;
+
+}  // namespace s21
+
+/*
+ * Dense matrix of float, double or long double elements. S21Matrix, the
+ * double instantiation, is the one the rest of the library is built around:
+ * views, lazy expressions, sparse and batched matrices and the file format
+ * all use it. Every instantiation runs its own specialization of the SIMD,
+ * GEMM, transpose and LU kernels.
+ */
+template <typename Scalar>
+class S21BasicMatrix {
+  friend class S21MatrixRef;
+  friend class S21BasicMatrixView<Scalar>;
+  friend class S21SparseMatrix;
+  friend class S21SymmetricMatrix;
 
-class S21Matrix {
  private:
-  int rows_, cols_;
-  double **matrix_;
+  // Elements live in one row-major buffer aligned to kAlignment bytes.
+  // Row i starts at matrix_ + i * ld_. The leading dimension ld_ is at least
+  // cols_; a fresh matrix rounds it up so that every row starts on an
+  // aligned boundary. The buffer holds row_capacity_ >= rows_ rows, so
+  // SetRows and SetCols stay in place while the new shape fits.
+  static constexpr std::size_t kAlignment = 64;
+  int rows_, cols_, ld_, row_capacity_;
+  Scalar *matrix_;
+  // LU or Cholesky factors of the current elements, built by the first
+  // Determinant, InverseMatrix or Solve and dropped by anything that may
+  // write an element. Moves carry them along; copies start without.
+  struct Factors;
+  std::unique_ptr<Factors> factors_;
+  Factors &factors(S21Factorization hint);
+  void invalidate_factors();
   void create_matrix();
   void remove_matrix();
-  void del_rc(S21Matrix &other, int num_i, int num_j);
-  void minor_matrix(S21Matrix &other);
-  void check_rows_cols(int rows, int cols);
-  void check_for_sum_sub(int rows1, int cols1, int rows2, int cols2);
+  static int leading_dimension(int cols);
+  static Scalar *allocate(std::size_t count);
+  static void deallocate(Scalar *data);
+  Scalar *row(int i) const { return matrix_ + std::ptrdiff_t(i) * ld_; }
+  void swap(S21BasicMatrix &other) noexcept;
+  void copy_rows(const S21BasicMatrix &other, int rows);
+  bool aliases(const S21BasicMatrixView<Scalar> &view) const;
+  template <typename E>
+  void assign(const E &expr);
+  static void lu_factor(Scalar *a, int n, int ld, int *pivot);
+  static void lu_inverse(Scalar *a, int n, int ld, const int *pivot);
+  static void lu_solve(const Scalar *a, int n, int ld, const int *pivot,
+                       Scalar *b, int cols, int ldb);
+  static bool cholesky_factor(Scalar *a, int n, int ld);
+  static void cholesky_inverse(Scalar *l, int n, int ld, Scalar *out,
+                               int ldo);
+  static void cholesky_solve(const Scalar *l, int n, int ld, Scalar *b,
+                             int cols, int ldb);
+  static std::vector<Scalar> row_tolerances(const Scalar *a, int n, int ld);
+  static int lu_factor_full(Scalar *a, int n, int ld, int *row_pivot,
+                            int *col_pivot);
+  void complements_from_factors(S21BasicMatrix &result) const;
+  void del_rc(S21BasicMatrix &other, int num_i, int num_j);
+  void minor_matrix(S21BasicMatrix &other);
+  static void check_rows_cols(int rows, int cols);
+  static void check_for_sum_sub(int rows1, int cols1, int rows2, int cols2);
 
  public:
-  S21Matrix();
-  S21Matrix(int rows, int cols);
-  S21Matrix(const S21Matrix &other);
-  S21Matrix(S21Matrix &&other);
-  ~S21Matrix();
-
-  int GetRows();
-  int GetCols();
+  S21BasicMatrix();
+  S21BasicMatrix(int rows, int cols);
+  S21BasicMatrix(const S21BasicMatrix &other);
+  S21BasicMatrix(S21BasicMatrix &&other) noexcept;
+  explicit S21BasicMatrix(const S21BasicMatrixView<Scalar> &view);
+  // Evaluate a lazy expression, see s21_matrix_expr.h.
+  template <typename E>
+  S21BasicMatrix(const S21Expr<E> &expr);
+  ~S21BasicMatrix();
+
+  int GetRows() const;
+  int GetCols() const;
+  // Shrinking keeps the buffer; growing past it reserves about twice the
+  // old capacity, so adding one row or column at a time is amortized linear.
   void SetRows(int rows);
   void SetCols(int cols);
+  // Makes room for rows x cols without changing the shape or the elements.
+  // Reallocating moves the elements, so views taken before it dangle.
+  void Reserve(int rows, int cols);
 
-  bool EqMatrix(const S21Matrix &other);
-  void SumMatrix(const S21Matrix &other);
-  void SubMatrix(const S21Matrix &other);
-  void MulNumber(const double num);
-  void MulMatrix(const S21Matrix &other);
-  S21Matrix Transpose();
-  S21Matrix CalcComplements();
-  double Determinant();
-  S21Matrix InverseMatrix();
-
-  S21Matrix operator+(const S21Matrix &other);
-  S21Matrix operator-(const S21Matrix &other);
-  S21Matrix operator*(const S21Matrix &other);
-  S21Matrix operator*(const double &num);
-  bool operator==(const S21Matrix &other);
-  S21Matrix &operator=(const S21Matrix &other);
-  S21Matrix &operator+=(const S21Matrix &other);
-  S21Matrix &operator-=(const S21Matrix &other);
-  S21Matrix &operator*=(const S21Matrix &other);
-  S21Matrix &operator*=(const double &num);
-  double &operator()(const int row, const int col);
+  bool EqMatrix(const S21BasicMatrix &other);
+  void SumMatrix(const S21BasicMatrix &other);
+  void SubMatrix(const S21BasicMatrix &other);
+  void MulNumber(const Scalar num);
+  void MulMatrix(const S21BasicMatrix &other);
+  void MulMatrix(const S21BasicMatrix &other, S21MulPolicy policy);
+  S21BasicMatrix Transpose();
+  void TransposeInPlace();
+
+  // Views read this matrix in place; see s21_matrix_view.h.
+  S21BasicMatrixView<Scalar> T() const;
+  S21BasicMatrixView<Scalar> Slice(int row, int col, int rows,
+                                   int cols) const;
+  bool EqMatrix(const S21BasicMatrixView<Scalar> &other);
+  void SumMatrix(const S21BasicMatrixView<Scalar> &other);
+  void SubMatrix(const S21BasicMatrixView<Scalar> &other);
+  void MulMatrix(const S21BasicMatrixView<Scalar> &other);
+  // this = alpha * a * b + beta * this in the existing storage. Pass a.T()
+  // or b.T() for a transposed operand; neither is copied unless it overlaps
+  // this. When beta is zero the old contents are never read.
+  void Gemm(Scalar alpha, const S21BasicMatrixView<Scalar> &a,
+            const S21BasicMatrixView<Scalar> &b, Scalar beta);
+  S21BasicMatrix CalcComplements();
+  Scalar Determinant();
+  Scalar Determinant(S21Factorization hint);
+  S21BasicMatrix LU(std::vector<int> &pivot) const;
+  // Lower triangular L with this = L * L^T, from the lower triangle of this;
+  // throws unless that describes a positive definite matrix.
+  S21BasicMatrix Cholesky() const;
+  bool IsSymmetric(Scalar tolerance = s21::kEqTolerance<Scalar>) const;
+  S21BasicMatrix InverseMatrix();
+  S21BasicMatrix InverseMatrix(S21Factorization hint);
+  // Returns X with this * X = other, one column of X per column of other,
+  // without forming the inverse.
+  S21BasicMatrix Solve(const S21BasicMatrix &other);
+  S21BasicMatrix Solve(const S21BasicMatrix &other, S21Factorization hint);
+
+  static void SetGemmBlocking(int mc, int kc, int nc);
+  static void SetThreadCount(int count);
+  // Writes the binary format of s21_matrix_file.h. MapFile maps such a file
+  // read-only without copying; verify_checksum hashes every data byte first.
+  // The format stores doubles, so these three exist for S21Matrix only;
+  // the other instantiations delete them below.
+  void Save(const std::string &path) const;
+  static S21MappedMatrix MapFile(const std::string &path,
+                                 bool verify_checksum = false);
+  // result = lhs * rhs for matrix files too large to load, keeping about
+  // memory_bytes of tiles in RAM; see s21_out_of_core.h.
+  static void MulFiles(const std::string &lhs, const std::string &rhs,
+                       const std::string &result,
+                       std::size_t memory_bytes = std::size_t(1) << 30);
+
+  static void SetStrassenCutoff(int cutoff);
+  static int TuneStrassenCutoff();
+
+  // Overloads taking an expiring operand return its storage as the result
+  // instead of allocating a new matrix.
+  S21BasicMatrix operator+(const S21BasicMatrix &other) const &;
+  S21BasicMatrix operator+(const S21BasicMatrix &other) &&;
+  S21BasicMatrix operator+(S21BasicMatrix &&other) const &;
+  S21BasicMatrix operator+(S21BasicMatrix &&other) &&;
+  S21BasicMatrix operator-(const S21BasicMatrix &other) const &;
+  S21BasicMatrix operator-(const S21BasicMatrix &other) &&;
+  S21BasicMatrix operator-(S21BasicMatrix &&other) const &;
+  S21BasicMatrix operator-(S21BasicMatrix &&other) &&;
+  S21BasicMatrix operator*(const S21BasicMatrix &other) const &;
+  S21BasicMatrix operator*(const S21BasicMatrix &other) &&;
+  S21BasicMatrix operator*(const Scalar &num) const &;
+  S21BasicMatrix operator*(const Scalar &num) &&;
+  bool operator==(const S21BasicMatrix &other);
+  S21BasicMatrix &operator=(const S21BasicMatrix &other);
+  S21BasicMatrix &operator=(S21BasicMatrix &&other) noexcept;
+  template <typename E>
+  S21BasicMatrix &operator=(const S21Expr<E> &expr);
+  S21BasicMatrix &operator+=(const S21BasicMatrix &other);
+  S21BasicMatrix &operator-=(const S21BasicMatrix &other);
+  S21BasicMatrix &operator*=(const S21BasicMatrix &other);
+  S21BasicMatrix &operator*=(const Scalar &num);
+  // Drops the cached factors, so write through the returned reference
+  // before the next Determinant, InverseMatrix or Solve, not after it.
+  Scalar &operator()(const int row, const int col);
+  const Scalar &operator()(const int row, const int col) const;
 };
 
+using S21Matrix = S21BasicMatrix<double>;
+
+template <>
+void S21Matrix::Save(const std::string &path) const;
+template <>
+S21MappedMatrix S21Matrix::MapFile(const std::string &path,
+                                   bool verify_checksum);
+template <>
+void S21Matrix::MulFiles(const std::string &lhs, const std::string &rhs,
+                         const std::string &result, std::size_t memory_bytes);
+
+// Deleted rather than left undefined, so using them fails to compile
+// instead of failing to link.
+template <>
+void S21BasicMatrix<float>::Save(const std::string &path) const = delete;
+template <>
+S21MappedMatrix S21BasicMatrix<float>::MapFile(const std::string &path,
+                                               bool verify_checksum) = delete;
+template <>
+void S21BasicMatrix<float>::MulFiles(const std::string &lhs,
+                                     const std::string &rhs,
+                                     const std::string &result,
+                                     std::size_t memory_bytes) = delete;
+template <>
+void S21BasicMatrix<long double>::Save(const std::string &path) const = delete;
+template <>
+S21MappedMatrix S21BasicMatrix<long double>::MapFile(
+    const std::string &path, bool verify_checksum) = delete;
+template <>
+void S21BasicMatrix<long double>::MulFiles(const std::string &lhs,
+                                           const std::string &rhs,
+                                           const std::string &result,
+                                           std::size_t memory_bytes) = delete;
+
+extern template class S21BasicMatrix<float>;
+extern template class S21BasicMatrix<double>;
+extern template class S21BasicMatrix<long double>;
+
 #endif  // SRC_S21_MATRIX_OOP_H_
@@ -1,6 +1,40 @@
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <type_traits>
+
+#include "s21_fixed_matrix.h"
+#include "s21_gemm.h"
+#include "s21_instrument.h"
+#include "s21_matrix_batch.h"
+#include "s21_matrix_expr.h"
 #include "s21_matrix_oop.h"
+#include "s21_out_of_core.h"
+#include "s21_simd.h"
+#include "s21_sparse_matrix.h"
+#include "s21_symmetric_matrix.h"
+#include "s21_thread_pool.h"
+
+static S21Matrix NaiveProduct(S21Matrix &a, S21Matrix &b) {
+  S21Matrix c(a.GetRows(), b.GetCols());
+  for (int i = 0; i < a.GetRows(); i++) {
+    for (int j = 0; j < b.GetCols(); j++) {
+      for (int k = 0; k < a.GetCols(); k++) c(i, j) += a(i, k) * b(k, j);
+    }
+  }
+  return c;
+}
+
+template <typename Matrix>
+static void FillPattern(Matrix &matrix, int seed) {
+  for (int i = 0; i < matrix.GetRows(); i++) {
+    for (int j = 0; j < matrix.GetCols(); j++) {
+      matrix(i, j) = ((i * 31 + j * 17 + seed) % 23) / 8.0 - 1.25;
+    }
+  }
+}
 
 TEST(Constructors, DefaultEqual) {
   S21Matrix matrix;
@@ -64,6 +98,15 @@ TEST(Constructors, Move) {
   }
 }
 
+TEST(Constructors, ContiguousAlignedRows) {
+  S21Matrix matrix(5, 3);
+  for (int i = 0; i < matrix.GetRows(); i++) {
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&matrix(i, 0)) % 64, 0u);
+    EXPECT_EQ(&matrix(i, 2) - &matrix(i, 0), 2);
+  }
+  EXPECT_EQ(&matrix(4, 0) - &matrix(0, 0), 4 * (&matrix(1, 0) - &matrix(0, 0)));
+}
+
 TEST(Getters, GetRows_cols) {
   S21Matrix mtr(2, 3);
   EXPECT_EQ(mtr.GetRows(), 2);
@@ -228,6 +271,59 @@ TEST(Setters, SetColsNotNullValue2) {
   }
 }
 
+TEST(Setters, GrowInPlace) {
+  S21Matrix matrix(1, 5);
+  matrix(0, 4) = 1;
+  for (int i = 1; i < 100; i++) {
+    matrix.SetRows(i + 1);
+    matrix(i, 4) = i + 1;
+  }
+  for (int i = 0; i < 100; i++) EXPECT_EQ(matrix(i, 4), i + 1);
+  // Shrinking keeps the buffer, and regrown rows come back as zeros.
+  const double *storage = &matrix(0, 0);
+  matrix.SetRows(10);
+  matrix.SetCols(3);
+  EXPECT_EQ(&matrix(0, 0), storage);
+  matrix.SetRows(20);
+  matrix.SetCols(5);
+  EXPECT_EQ(&matrix(0, 0), storage);
+  EXPECT_EQ(matrix(9, 4), 0);
+  EXPECT_EQ(matrix(15, 0), 0);
+  matrix.Reserve(30, 5);
+  EXPECT_EQ(&matrix(0, 0), storage);
+  matrix.Reserve(30, 40);
+  EXPECT_EQ(matrix.GetRows(), 20);
+  EXPECT_EQ(matrix.GetCols(), 5);
+  EXPECT_EQ(matrix(5, 4), 0);
+  EXPECT_EQ(matrix(0, 0), 0);
+  matrix(0, 0) = 7;
+  storage = &matrix(0, 0);
+  matrix.SetCols(40);
+  matrix.SetRows(30);
+  EXPECT_EQ(&matrix(0, 0), storage);
+  EXPECT_EQ(matrix(0, 0), 7);
+  EXPECT_THROW(matrix.Reserve(0, 5), std::out_of_range);
+  EXPECT_THROW(matrix.SetCols(0), std::out_of_range);
+}
+
+TEST(Setters, GrowAfterTranspose) {
+  S21Matrix matrix(6, 4);
+  FillPattern(matrix, 2);
+  S21Matrix expected = matrix.Transpose();
+  matrix.SetRows(3);
+  matrix.SetRows(6);
+  for (int i = 3; i < 6; i++) {
+    for (int j = 0; j < 4; j++) expected(j, i) = 0;
+  }
+  matrix.TransposeInPlace();
+  EXPECT_TRUE(matrix.EqMatrix(expected));
+  matrix.SetCols(7);
+  matrix.SetRows(5);
+  expected.SetCols(7);
+  expected.SetRows(5);
+  EXPECT_TRUE(matrix.EqMatrix(expected));
+}
+
 TEST(Methods, EqMatrixSuccess) {
   S21Matrix matrix1(3, 3);
   S21Matrix matrix2(3, 3);
@@ -249,6 +345,54 @@ TEST(Methods, EqMatrixFailure) {
   EXPECT_FALSE(matrix4.EqMatrix(matrix3));
 }
 
+// Every SIMD table of element type T against the scalar one.
+template <typename T>
+static void ExpectKernelsAgree() {
+  const std::size_t n = 37;
+  T a[n], b[n], sum[n], diff[n], scaled[n];
+  for (std::size_t i = 0; i < n; i++) {
+    a[i] = sum[i] = diff[i] = scaled[i] = T(i * 0.5 - 3);
+    b[i] = T(7 - i * 0.25);
+  }
+  const int rows = 19, cols = 13;
+  T tile[rows * cols], expected[rows * cols], transposed[rows * cols];
+  for (int i = 0; i < rows * cols; i++) tile[i] = T(i);
+  const s21::ElementwiseKernels<T> &scalar =
+      s21::KernelsFor<T>(s21::SimdLevel::kScalar);
+  scalar.add(sum, b, n);
+  scalar.sub(diff, b, n);
+  scalar.scale(scaled, T(-1.5), n);
+  scalar.transpose(rows, cols, tile, cols, expected, rows);
+  for (s21::SimdLevel level : {s21::SimdLevel::kSse2, s21::SimdLevel::kAvx2,
+                               s21::SimdLevel::kAvx512}) {
+    const s21::ElementwiseKernels<T> &kernels = s21::KernelsFor<T>(level);
+    T x[n], y[n], z[n], w[n];
+    for (std::size_t i = 0; i < n; i++) x[i] = y[i] = z[i] = w[i] = a[i];
+    kernels.add(x, b, n);
+    kernels.sub(y, b, n);
+    kernels.scale(z, T(-1.5), n);
+    kernels.rsub(w, b, n);
+    kernels.scale(w, T(-1), n);
+    EXPECT_TRUE(scalar.near(x, sum, n, 0));
+    EXPECT_TRUE(scalar.near(y, diff, n, 0));
+    EXPECT_TRUE(scalar.near(z, scaled, n, 0));
+    EXPECT_TRUE(scalar.near(w, diff, n, 0));
+    x[n - 1] += T(1e-3);
+    EXPECT_FALSE(kernels.near(x, sum, n, T(1e-4)));
+    EXPECT_TRUE(kernels.near(x, sum, n, T(1e-2)));
+    x[n - 1] = sum[n - 1];
+    x[1] -= T(1e-3);
+    EXPECT_FALSE(kernels.near(x, sum, n, T(1e-4)));
+    kernels.transpose(rows, cols, tile, cols, transposed, rows);
+    EXPECT_TRUE(scalar.near(transposed, expected, rows * cols, 0));
+  }
+}
+
+TEST(Methods, ElementwiseKernelsAgree) {
+  ExpectKernelsAgree<double>();
+  ExpectKernelsAgree<float>();
+}
+
 TEST(Methods, SumMatrixSuccess) {
   S21Matrix matrix1(3, 3);
   S21Matrix matrix2(3, 3);
@@ -314,6 +458,179 @@ TEST(Methods, MulMatrixSuccess) {
   EXPECT_TRUE(matrix1.EqMatrix(matrix3));
 }
 
+TEST(Methods, MulMatrixBlocked) {
+  S21Matrix matrix1(67, 45);
+  S21Matrix matrix2(45, 83);
+  FillPattern(matrix1, 1);
+  FillPattern(matrix2, 2);
+  S21Matrix expected = NaiveProduct(matrix1, matrix2);
+  S21Matrix::SetGemmBlocking(8, 16, 24);
+  S21Matrix result(matrix1);
+  result.MulMatrix(matrix2);
+  S21Matrix::SetGemmBlocking(128, 256, 4096);
+  EXPECT_EQ(result.GetRows(), 67);
+  EXPECT_EQ(result.GetCols(), 83);
+  EXPECT_TRUE(result.EqMatrix(expected));
+  matrix1.MulMatrix(matrix2);
+  EXPECT_TRUE(matrix1.EqMatrix(expected));
+}
+
+TEST(Methods, MulMatrixParallel) {
+  S21Matrix matrix1(190, 150);
+  S21Matrix matrix2(150, 170);
+  FillPattern(matrix1, 6);
+  FillPattern(matrix2, 7);
+  S21Matrix::SetThreadCount(1);
+  S21Matrix serial = matrix1 * matrix2;
+  S21Matrix::SetThreadCount(4);
+  EXPECT_EQ(s21::ThreadPool::Instance().ThreadCount(), 4);
+  S21Matrix parallel = matrix1 * matrix2;
+  EXPECT_TRUE(parallel.EqMatrix(serial));
+  EXPECT_TRUE(parallel.EqMatrix(NaiveProduct(matrix1, matrix2)));
+  S21Matrix::SetThreadCount(0);
+}
+
+TEST(Methods, ThreadPool) {
+  setenv("S21_NUM_THREADS", "3", 1);
+  S21Matrix::SetThreadCount(0);
+  EXPECT_EQ(s21::ThreadPool::Instance().ThreadCount(), 3);
+  std::vector<int> hits(1000);
+  s21::ThreadPool::Instance().ParallelFor(1000, [&](int i) {
+    s21::ThreadPool::Instance().ParallelFor(2,
+                                            [&](int j) { hits[i] += j + 1; });
+  });
+  for (int hit : hits) EXPECT_EQ(hit, 3);
+  std::vector<int> counts(8);
+  s21::ThreadPool::Instance().ParallelFor(8, [&](int i) {
+    counts[i] = s21::ThreadPool::Instance().ThreadCount();
+  });
+  for (int count : counts) EXPECT_EQ(count, 1);
+  S21Matrix::SetThreadCount(1);
+  s21::ThreadPool::Instance().ParallelFor(8, [&](int i) {
+    counts[i] = s21::ThreadPool::Instance().ThreadCount() + 1;
+  });
+  for (int count : counts) EXPECT_EQ(count, 2);
+
+  // A throwing task reaches the caller and leaves the pool usable, on the
+  // serial path and on the workers.
+  for (int threads : {1, 4}) {
+    S21Matrix::SetThreadCount(threads);
+    EXPECT_THROW(s21::ThreadPool::Instance().ParallelFor(
+                     100,
+                     [](int i) {
+                       if (i == 37) throw std::runtime_error("task failed");
+                     }),
+                 std::runtime_error);
+    EXPECT_EQ(s21::ThreadPool::Instance().ThreadCount(), threads);
+    std::vector<int> after(100);
+    s21::ThreadPool::Instance().ParallelFor(100, [&](int i) { after[i] = 1; });
+    for (int hit : after) EXPECT_EQ(hit, 1);
+  }
+  unsetenv("S21_NUM_THREADS");
+  S21Matrix::SetThreadCount(0);
+}
+
+TEST(Methods, GemmStridedAlphaBeta) {
+  S21Matrix a(40, 50);
+  S21Matrix b(40, 60);
+  S21Matrix c(50, 60);
+  FillPattern(a, 3);
+  FillPattern(b, 4);
+  FillPattern(c, 5);
+  S21Matrix at = a.Transpose();
+  S21Matrix expected = NaiveProduct(at, b);
+  expected.MulNumber(0.5);
+  S21Matrix c2 = c * 2.0;
+  expected.SumMatrix(c2);
+  // C = 0.5 * A^T * B + 2 * C, reading A through swapped strides.
+  const std::ptrdiff_t lda = &a(1, 0) - &a(0, 0);
+  const std::ptrdiff_t ldb = &b(1, 0) - &b(0, 0);
+  const std::ptrdiff_t ldc = &c(1, 0) - &c(0, 0);
+  s21::Gemm(50, 60, 40, 0.5, &a(0, 0), 1, lda, &b(0, 0), ldb, 1, 2.0,
+            &c(0, 0), ldc);
+  EXPECT_TRUE(c.EqMatrix(expected));
+}
+
+TEST(Methods, GemmMember) {
+  S21Matrix a(30, 20);
+  S21Matrix b(20, 25);
+  S21Matrix c(30, 25);
+  FillPattern(a, 1);
+  FillPattern(b, 2);
+  FillPattern(c, 3);
+  S21Matrix expected = NaiveProduct(a, b) * 1.5 + c * -0.5;
+  const double *storage = &c(0, 0);
+  c.Gemm(1.5, a, b, -0.5);
+  EXPECT_EQ(&c(0, 0), storage);
+  EXPECT_TRUE(c.EqMatrix(expected));
+  // Transposed operands are read through views, beta = 0 ignores c.
+  S21Matrix at = a.Transpose();
+  S21Matrix bt = b.Transpose();
+  c.Gemm(1.0, at.T(), bt.T(), 0.0);
+  EXPECT_TRUE(c.EqMatrix(a * b));
+  EXPECT_THROW(c.Gemm(1.0, a, a, 1.0), std::out_of_range);
+  EXPECT_THROW(c.Gemm(1.0, b, b.T(), 1.0), std::out_of_range);
+}
+
+TEST(Methods, GemmAliased) {
+  S21Matrix a(16, 16);
+  FillPattern(a, 4);
+  S21Matrix copy(a);
+  S21Matrix expected = NaiveProduct(copy, copy) + copy;
+  a.Gemm(1.0, a, a.T().T(), 1.0);
+  EXPECT_TRUE(a.EqMatrix(expected));
+}
+
+TEST(Methods, GemmVectorShapes) {
+  S21Matrix::SetThreadCount(4);
+  for (int size : {7, 700}) {
+    S21Matrix a(size, size + 3);
+    S21Matrix x(size + 3, 1);
+    S21Matrix row(1, size);
+    FillPattern(a, 5);
+    FillPattern(x, 6);
+    FillPattern(row, 7);
+    S21Matrix at = a.Transpose();
+    S21Matrix rowt = row.Transpose();
+    // n == 1: y = A * x, with A by rows and by columns.
+    S21Matrix y(size, 1);
+    FillPattern(y, 8);
+    S21Matrix expected = NaiveProduct(a, x) * 2.0 + y;
+    y.Gemm(2.0, a, x, 1.0);
+    EXPECT_TRUE(y.EqMatrix(expected));
+    y.Gemm(1.0, at.T(), x, 0.0);
+    EXPECT_TRUE(y.EqMatrix(NaiveProduct(a, x)));
+    // m == 1: y^T = row * A, and the same through a transposed A.
+    S21Matrix z(1, size + 3);
+    z.Gemm(1.0, row, a, 0.0);
+    EXPECT_TRUE(z.EqMatrix(NaiveProduct(row, a)));
+    z.Gemm(1.0, rowt.T(), at.T(), 0.0);
+    EXPECT_TRUE(z.EqMatrix(NaiveProduct(row, a)));
+  }
+  S21Matrix::SetThreadCount(0);
+}
+
+TEST(Methods, MulMatrixStrassen) {
+  S21Matrix matrix1(101, 77);
+  S21Matrix matrix2(77, 93);
+  FillPattern(matrix1, 8);
+  FillPattern(matrix2, 9);
+  S21Matrix expected = NaiveProduct(matrix1, matrix2);
+  // A small cutoff forces several levels and peels every odd edge.
+  S21Matrix::SetStrassenCutoff(8);
+  S21Matrix result(matrix1);
+  result.MulMatrix(matrix2, S21MulPolicy::kStrassen);
+  S21Matrix::SetStrassenCutoff(512);
+  EXPECT_EQ(result.GetRows(), 101);
+  EXPECT_EQ(result.GetCols(), 93);
+  EXPECT_TRUE(result.EqMatrix(expected));
+  S21Matrix classic(matrix1);
+  classic.MulMatrix(matrix2, S21MulPolicy::kClassic);
+  EXPECT_TRUE(classic.EqMatrix(matrix1 * matrix2));
+  EXPECT_THROW(matrix2.MulMatrix(matrix2, S21MulPolicy::kStrassen),
+               std::out_of_range);
+}
+
 TEST(Methods, MulMatrixFailure) {
   S21Matrix matrix1(3, 2);
   S21Matrix matrix2(3, 3);
@@ -341,6 +658,56 @@ TEST(Methods, Transpose) {
   EXPECT_TRUE(matrix3.EqMatrix(matrix2));
 }
 
+TEST(Methods, TransposeTiled) {
+  for (int rows : {1, 7, 33, 130}) {
+    for (int cols : {1, 5, 64, 97}) {
+      S21Matrix matrix1(rows, cols);
+      FillPattern(matrix1, rows + cols);
+      S21Matrix matrix2 = matrix1.Transpose();
+      ASSERT_EQ(matrix2.GetRows(), cols);
+      ASSERT_EQ(matrix2.GetCols(), rows);
+      for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) ASSERT_EQ(matrix2(j, i), matrix1(i, j));
+      }
+    }
+  }
+}
+
+TEST(Methods, TransposeInPlace) {
+  S21Matrix square(70, 70);
+  FillPattern(square, 1);
+  S21Matrix expected = square.Transpose();
+  const double *storage = &square(0, 0);
+  square.TransposeInPlace();
+  EXPECT_EQ(&square(0, 0), storage);
+  EXPECT_TRUE(square == expected);
+
+  for (int rows : {3, 37}) {
+    S21Matrix matrix1(rows, 21);
+    FillPattern(matrix1, rows);
+    expected = matrix1.Transpose();
+    storage = &matrix1(0, 0);
+    matrix1.TransposeInPlace();
+    EXPECT_EQ(&matrix1(0, 0), storage);
+    EXPECT_EQ(matrix1.GetRows(), 21);
+    EXPECT_EQ(matrix1.GetCols(), rows);
+    EXPECT_TRUE(matrix1 == expected);
+
+    S21Matrix copy(matrix1);
+    EXPECT_TRUE(copy == expected);
+    copy = expected;
+    expected = matrix1;
+    EXPECT_TRUE(copy == expected);
+    matrix1.SumMatrix(copy);
+    matrix1.SetRows(22);
+    copy.MulNumber(2);
+    EXPECT_TRUE(copy.EqMatrix(matrix1.Slice(0, 0, 21, rows)));
+    matrix1.TransposeInPlace();
+    matrix1.SetCols(21);
+    EXPECT_TRUE(matrix1 == copy.Transpose());
+  }
+}
+
 TEST(Methods, Determinant) {
   S21Matrix matrix1(4, 4);
   matrix1(0, 0) = 9;
@@ -392,6 +759,52 @@ TEST(Methods, DeterminantDop) {
   EXPECT_EQ(matrix1.Determinant(), -8);
 }
 
+TEST(Methods, DeterminantLarge) {
+  const int n = 60;
+  S21Matrix matrix1(n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = i; j < n; j++) {
+      matrix1(i, j) = (i == j) ? 2 : 1;
+    }
+  }
+  S21Matrix perm(n, n);
+  for (int i = 0; i < n; i++) perm((i + 1) % n, i) = 1;
+  S21Matrix matrix2 = perm * matrix1;
+  EXPECT_NEAR(matrix1.Determinant(), std::pow(2.0, n), 1e-3);
+  EXPECT_NEAR(matrix2.Determinant() / std::pow(2.0, n), n % 2 ? 1 : -1, 1e-9);
+}
+
+TEST(Methods, LU) {
+  S21Matrix matrix1(3, 3);
+  matrix1(0, 0) = 1;
+  matrix1(0, 1) = 2;
+  matrix1(0, 2) = 3;
+  matrix1(1, 0) = 4;
+  matrix1(1, 1) = 5;
+  matrix1(1, 2) = 6;
+  matrix1(2, 0) = 7;
+  matrix1(2, 1) = 8;
+  matrix1(2, 2) = 10;
+  std::vector<int> pivot;
+  S21Matrix lu = matrix1.LU(pivot);
+  S21Matrix l(3, 3);
+  S21Matrix u(3, 3);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      if (j < i) l(i, j) = lu(i, j);
+      if (j >= i) u(i, j) = lu(i, j);
+    }
+    l(i, i) = 1;
+  }
+  S21Matrix pa(matrix1);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) std::swap(pa(i, j), pa(pivot[i], j));
+  }
+  EXPECT_EQ(pivot[0], 2);
+  EXPECT_TRUE((l * u).EqMatrix(pa));
+  EXPECT_THROW(S21Matrix(2, 3).LU(pivot), std::out_of_range);
+}
+
 TEST(Methods, DeterminantExcept) {
   S21Matrix matrix1(3, 2);
   EXPECT_THROW(matrix1.Determinant(), std::out_of_range);
@@ -433,6 +846,75 @@ TEST(Methods, CalcComplements) {
   EXPECT_TRUE(matrix4.EqMatrix(matrix2));
 }
 
+static S21Matrix CofactorsByMinors(const S21Matrix &matrix) {
+  const int n = matrix.GetRows();
+  S21Matrix result(n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      S21Matrix minor(n - 1, n - 1);
+      for (int r = 0; r < n - 1; r++) {
+        for (int c = 0; c < n - 1; c++) {
+          minor(r, c) = matrix(r + (r >= i), c + (c >= j));
+        }
+      }
+      result(i, j) = ((i + j) % 2 ? -1 : 1) * minor.Determinant();
+    }
+  }
+  return result;
+}
+
+TEST(Methods, CalcComplementsFactored) {
+  S21Matrix matrix1(6, 6);
+  FillPattern(matrix1, 5);
+  for (int i = 0; i < 6; i++) matrix1(i, i) += 3;
+  EXPECT_TRUE(matrix1.CalcComplements().EqMatrix(CofactorsByMinors(matrix1)));
+
+  // Rank 5: the last row is a combination of two others.
+  S21Matrix matrix2(matrix1);
+  for (int j = 0; j < 6; j++) matrix2(5, j) = matrix2(0, j) - 2 * matrix2(3, j);
+  S21Matrix expected = CofactorsByMinors(matrix2);
+  EXPECT_GT(std::fabs(expected(5, 2)), 1e-3);
+  EXPECT_TRUE(matrix2.CalcComplements().EqMatrix(expected));
+
+  // Rank 4: every cofactor vanishes.
+  for (int j = 0; j < 6; j++) matrix2(4, j) = matrix2(1, j) + matrix2(2, j);
+  EXPECT_TRUE(matrix2.CalcComplements().EqMatrix(S21Matrix(6, 6)));
+}
+
+// Full rank however small the other rows look next to the first.
+TEST(Methods, CalcComplementsBadlyScaled) {
+  S21Matrix matrix(4, 4);
+  matrix(0, 0) = 1e16;
+  matrix(0, 1) = 1;
+  for (int i = 1; i < 4; i++) matrix(i, i) = 1;
+  matrix(3, 1) = 0.5;
+  S21Matrix complements = matrix.CalcComplements();
+  S21Matrix expected = CofactorsByMinors(matrix);
+  EXPECT_EQ(expected(0, 0), 1);
+  EXPECT_EQ(expected(1, 1), 1e16);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      EXPECT_NEAR(complements(i, j), expected(i, j),
+                  1e-12 * std::max(1.0, std::fabs(expected(i, j))));
+    }
+  }
+}
+
+TEST(Methods, CalcComplementsLarge) {
+  const int n = 200;
+  S21Matrix matrix1(n, n);
+  FillPattern(matrix1, 8);
+  for (int i = 0; i < n; i++) matrix1(i, i) += 5;
+  S21Matrix complements = matrix1.CalcComplements();
+  // A * adj(A) = det(A) * I, scaled down to keep the tolerance meaningful.
+  const double det = matrix1.Determinant();
+  S21Matrix product = matrix1 * complements.Transpose();
+  product.MulNumber(1 / det);
+  S21Matrix identity(n, n);
+  for (int i = 0; i < n; i++) identity(i, i) = 1;
+  EXPECT_TRUE(product.EqMatrix(identity));
+}
+
 TEST(Methods, CalcComplementsExcept) {
   S21Matrix matrix1(5, 4);
   EXPECT_THROW(matrix1.CalcComplements(), std::out_of_range);
@@ -485,6 +967,21 @@ TEST(Methods, InverseMatrixDop) {
   EXPECT_EQ(matrix1(2, 2), -13);
 }
 
+TEST(Methods, InverseMatrixLarge) {
+  const int n = 50;
+  S21Matrix matrix1(n, n);
+  S21Matrix identity(n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      matrix1(i, j) = ((i * 7 + j * 13) % 17) - 8 + (i == j ? 40 : 0);
+    }
+    identity(i, i) = 1;
+  }
+  S21Matrix matrix2 = matrix1.InverseMatrix();
+  EXPECT_TRUE((matrix1 * matrix2).EqMatrix(identity));
+  EXPECT_TRUE((matrix2 * matrix1).EqMatrix(identity));
+}
+
 TEST(Methods, InverseMatrixExcept) {
   S21Matrix matrix1(3, 3);
 
@@ -501,9 +998,143 @@ TEST(Methods, InverseMatrixExcept) {
   EXPECT_THROW(matrix1.InverseMatrix(), std::out_of_range);
 }
 
+// Elimination leaves a rounding residue instead of an exact zero pivot.
+TEST(Methods, InverseMatrixExceptRounded) {
+  S21Matrix matrix1(3, 3);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) matrix1(i, j) = i * 3 + j + 1;
+  }
+  S21Matrix matrix2(3, 1);
+  EXPECT_EQ(matrix1.Determinant(), 0);
+  EXPECT_EQ(matrix1.Determinant(S21Factorization::kLU), 0);
+  EXPECT_THROW(matrix1.InverseMatrix(), std::out_of_range);
+  EXPECT_THROW(matrix1.Solve(matrix2), std::out_of_range);
+  EXPECT_THROW(matrix1.InverseMatrix(S21Factorization::kLU),
+               std::out_of_range);
+}
+
+// Badly scaled but far from singular: the small pivots are small only next
+// to the first row, not next to their own rows.
+TEST(Methods, InverseMatrixBadlyScaled) {
+  S21Matrix matrix(3, 3);
+  matrix(0, 0) = 1e16;
+  matrix(0, 1) = 1;
+  matrix(1, 1) = 1;
+  matrix(2, 2) = 1;
+  EXPECT_DOUBLE_EQ(S21Matrix(matrix).Determinant(), 1e16);
+  S21Matrix inverse = matrix.InverseMatrix();
+  EXPECT_DOUBLE_EQ(inverse(0, 0), 1e-16);
+  EXPECT_DOUBLE_EQ(inverse(0, 1), -1e-16);
+  EXPECT_DOUBLE_EQ(inverse(1, 1), 1);
+  EXPECT_DOUBLE_EQ(inverse(2, 2), 1);
+  S21Matrix rhs(3, 1);
+  rhs(1, 0) = 1;
+  EXPECT_DOUBLE_EQ(matrix.Solve(rhs)(1, 0), 1);
+}
+
 TEST(Methods, InverseMatrixExceptDop) {
   S21Matrix matrix1(5, 4);
   EXPECT_THROW(matrix1.CalcComplements(), std::out_of_range);
+  S21Matrix matrix2(40, 1);
+  EXPECT_THROW(matrix2.InverseMatrix(), std::out_of_range);
+  EXPECT_THROW(matrix2.InverseMatrix(S21Factorization::kCholesky),
+               std::out_of_range);
+}
+
+TEST(Methods, Solve) {
+  S21Matrix matrix1(3, 3);
+  S21Matrix matrix2(3, 1);
+  matrix1(0, 0) = 2;
+  matrix1(0, 1) = 1;
+  matrix1(0, 2) = -1;
+  matrix1(1, 0) = -3;
+  matrix1(1, 1) = -1;
+  matrix1(1, 2) = 2;
+  matrix1(2, 0) = -2;
+  matrix1(2, 1) = 1;
+  matrix1(2, 2) = 2;
+  matrix2(0, 0) = 8;
+  matrix2(1, 0) = -11;
+  matrix2(2, 0) = -3;
+  S21Matrix matrix3 = matrix1.Solve(matrix2);
+  EXPECT_EQ(matrix3.GetRows(), 3);
+  EXPECT_EQ(matrix3.GetCols(), 1);
+  EXPECT_NEAR(matrix3(0, 0), 2, 1e-12);
+  EXPECT_NEAR(matrix3(1, 0), 3, 1e-12);
+  EXPECT_NEAR(matrix3(2, 0), -1, 1e-12);
+}
+
+TEST(Methods, SolveLarge) {
+  // Spans several substitution blocks and, with four threads, several
+  // panels of right-hand sides, the last one narrower than the rest.
+  const int n = 150;
+  S21Matrix matrix1(n, n);
+  S21Matrix matrix2(n, 37);
+  FillPattern(matrix1, 4);
+  FillPattern(matrix2, 9);
+  for (int i = 0; i < n; i++) matrix1(i, i) += 10;
+  S21Matrix::SetThreadCount(4);
+  S21Matrix matrix3 = matrix1.Solve(matrix2);
+  S21Matrix::SetThreadCount(0);
+  EXPECT_TRUE(NaiveProduct(matrix1, matrix3).EqMatrix(matrix2));
+  EXPECT_TRUE(matrix3.EqMatrix(matrix1.InverseMatrix() * matrix2));
+}
+
+TEST(Methods, SolveExcept) {
+  S21Matrix matrix1(3, 3);
+  S21Matrix matrix2(3, 2);
+  matrix1(0, 0) = 1;
+  matrix1(0, 1) = 4;
+  matrix1(0, 2) = 1;
+  matrix1(1, 0) = 3;
+  matrix1(1, 1) = 7;
+  matrix1(1, 2) = 2;
+  matrix1(2, 0) = 3;
+  matrix1(2, 1) = 2;
+  matrix1(2, 2) = 1;
+  EXPECT_THROW(matrix1.Solve(matrix2), std::out_of_range);
+  S21Matrix matrix3(4, 2);
+  matrix1(2, 2) = 5;
+  EXPECT_THROW(matrix1.Solve(matrix3), std::out_of_range);
+  S21Matrix matrix4(3, 4);
+  EXPECT_THROW(matrix4.Solve(matrix2), std::out_of_range);
+}
+
+TEST(Methods, FactorsCached) {
+  S21Matrix matrix1(4, 4);
+  FillPattern(matrix1, 3);
+  for (int i = 0; i < 4; i++) matrix1(i, i) += 4;
+  S21Matrix expected(matrix1);
+  const double det = matrix1.Determinant();
+  S21Matrix inverse = matrix1.InverseMatrix();
+  EXPECT_DOUBLE_EQ(matrix1.Determinant(), det);
+  EXPECT_TRUE(matrix1.InverseMatrix().EqMatrix(inverse));
+  EXPECT_TRUE(matrix1.Solve(expected).EqMatrix(inverse * expected));
+
+  // Every kind of write has to drop the cached factors.
+  matrix1.MulNumber(2);
+  EXPECT_NEAR(matrix1.Determinant(), 16 * det, 1e-9);
+  matrix1.MulNumber(0.5);
+  matrix1(0, 0) += 1;
+  expected(0, 0) += 1;
+  EXPECT_NEAR(matrix1.Determinant(), expected.Determinant(), 1e-9);
+  matrix1.SumMatrix(expected);
+  EXPECT_NEAR(matrix1.Determinant(), 16 * expected.Determinant(), 1e-9);
+  matrix1 = expected;
+  EXPECT_TRUE(matrix1.InverseMatrix().EqMatrix(expected.InverseMatrix()));
+  matrix1 = S21Lazy(matrix1) * 3.0;
+  EXPECT_NEAR(matrix1.Determinant(), 81 * expected.Determinant(), 1e-9);
+  matrix1.SetRows(3);
+  matrix1.SetRows(4);
+  EXPECT_EQ(matrix1.Determinant(), 0);
+  EXPECT_THROW(matrix1.InverseMatrix(), std::out_of_range);
+
+  // Moves keep the factors, copies compute their own.
+  S21Matrix moved(std::move(expected));
+  S21Matrix copy(moved);
+  EXPECT_NEAR(moved.Determinant(), copy.Determinant(), 1e-9);
+  copy(1, 1) += 1;
+  EXPECT_FALSE(copy.InverseMatrix().EqMatrix(moved.InverseMatrix()));
 }
 
 TEST(Operators, OperatorSum) {
@@ -514,6 +1145,76 @@ TEST(Operators, OperatorSum) {
   EXPECT_TRUE(matrix3.EqMatrix(matrix2));
 }
 
+TEST(Operators, OperatorRvalueReusesStorage) {
+  S21Matrix matrix1(4, 4);
+  S21Matrix matrix2(4, 4);
+  S21Matrix matrix3(4, 4);
+  FillPattern(matrix1, 1);
+  FillPattern(matrix2, 2);
+  FillPattern(matrix3, 3);
+  S21Matrix expected(matrix1);
+  expected.SumMatrix(matrix2);
+  expected.SubMatrix(matrix3);
+  expected.MulNumber(2);
+
+  S21Matrix sum = matrix1 + matrix2;
+  const double *storage = &sum(0, 0);
+  S21Matrix result = (std::move(sum) - matrix3) * 2.0;
+  EXPECT_EQ(&result(0, 0), storage);
+  EXPECT_TRUE(result.EqMatrix(expected));
+  EXPECT_TRUE((matrix1 + matrix2 - matrix3) * 2.0 == expected);
+
+  S21Matrix negated = matrix3 * -1.0;
+  storage = &negated(0, 0);
+  S21Matrix difference = matrix1 - std::move(negated);
+  EXPECT_EQ(&difference(0, 0), storage);
+  S21Matrix plus(matrix1);
+  plus.SumMatrix(matrix3);
+  EXPECT_TRUE(difference.EqMatrix(plus));
+  EXPECT_THROW(matrix1 - S21Matrix(3, 4), std::out_of_range);
+}
+
+TEST(Operators, OperatorMoveAssign) {
+  S21Matrix matrix1(2, 3);
+  matrix1(1, 2) = 4;
+  const double *storage = &matrix1(0, 0);
+  S21Matrix matrix2(5, 5);
+  matrix2 = std::move(matrix1);
+  EXPECT_EQ(matrix2.GetRows(), 2);
+  EXPECT_EQ(matrix2.GetCols(), 3);
+  EXPECT_EQ(&matrix2(0, 0), storage);
+  EXPECT_EQ(matrix2(1, 2), 4);
+  EXPECT_EQ(matrix1.GetRows(), 0);
+  EXPECT_EQ(matrix1.GetCols(), 0);
+}
+
+TEST(Operators, LazyExpression) {
+  S21Matrix matrix1(5, 6);
+  S21Matrix matrix2(5, 6);
+  S21Matrix matrix3(5, 6);
+  FillPattern(matrix1, 1);
+  FillPattern(matrix2, 2);
+  FillPattern(matrix3, 3);
+  S21Matrix expected = (matrix1 + matrix2 - matrix3 * 2.0) * -0.5;
+
+  S21Matrix result = -0.5 * (S21Lazy(matrix1) + matrix2 - matrix3 * 2.0);
+  EXPECT_TRUE(result.EqMatrix(expected));
+  result = -(S21Lazy(matrix1) - S21Lazy(matrix3)) + matrix1;
+  EXPECT_TRUE(result.EqMatrix(matrix3));
+
+  S21Matrix inplace(matrix1);
+  const double *storage = &inplace(0, 0);
+  inplace = S21Lazy(inplace) + matrix2 - S21Lazy(matrix3) * 2.0;
+  EXPECT_EQ(&inplace(0, 0), storage);
+  EXPECT_TRUE(inplace.EqMatrix(expected * -2.0));
+
+  S21Matrix square(6, 5);
+  FillPattern(square, 4);
+  S21Matrix product = (S21Lazy(matrix1) + matrix2) * square;
+  EXPECT_TRUE(product.EqMatrix((matrix1 + matrix2) * square));
+  EXPECT_THROW(S21Lazy(matrix1) + square, std::out_of_range);
+}
+
 TEST(Operators, OperatorSumExcept) {
   S21Matrix matrix1(5, 5);
   S21Matrix matrix2(6, 5);
@@ -663,6 +1364,702 @@ TEST(assignmentOperator, OperatorBracketExceptDop2) {
   EXPECT_THROW(matrix1(1, 5), std::out_of_range);
 }
 
+TEST(Views, TransposeAndSlice) {
+  S21Matrix matrix1(3, 2);
+  matrix1(0, 0) = 1;
+  matrix1(0, 1) = 2;
+  matrix1(1, 0) = 3;
+  matrix1(1, 1) = 4;
+  matrix1(2, 0) = 5;
+  matrix1(2, 1) = 6;
+  S21MatrixView view = matrix1.T();
+  EXPECT_EQ(view.GetRows(), 2);
+  EXPECT_EQ(view.GetCols(), 3);
+  EXPECT_EQ(&view(1, 2), &matrix1(2, 1));
+  EXPECT_TRUE(matrix1.Transpose().EqMatrix(view));
+  S21MatrixView slice = matrix1.Slice(1, 0, 2, 2);
+  EXPECT_EQ(slice(0, 0), 3);
+  EXPECT_EQ(slice.T()(1, 0), 4);
+  EXPECT_EQ(slice.Slice(1, 1, 1, 1)(0, 0), 6);
+  EXPECT_THROW(matrix1.Slice(2, 0, 2, 2), std::out_of_range);
+  EXPECT_THROW(view(2, 0), std::out_of_range);
+  S21Matrix copy(slice.T());
+  EXPECT_EQ(copy.GetRows(), 2);
+  EXPECT_EQ(copy(1, 1), 6);
+}
+
+TEST(Views, ArithmeticOnViews) {
+  S21Matrix matrix1(40, 30);
+  S21Matrix matrix2(40, 50);
+  FillPattern(matrix1, 1);
+  FillPattern(matrix2, 2);
+  S21Matrix transposed = matrix1.Transpose();
+  S21Matrix expected = transposed * matrix2;
+  EXPECT_TRUE((matrix1.T() * matrix2).EqMatrix(expected));
+  EXPECT_TRUE((transposed * matrix2.T().T()).EqMatrix(expected));
+  S21Matrix product(transposed);
+  product.MulMatrix(matrix2.Slice(0, 0, 40, 50));
+  EXPECT_TRUE(product.EqMatrix(expected));
+
+  S21Matrix square(6, 6);
+  FillPattern(square, 3);
+  S21Matrix symmetric = square + square.T();
+  EXPECT_TRUE(symmetric.EqMatrix(symmetric.T()));
+  S21Matrix inplace(square);
+  inplace.SumMatrix(inplace.T());
+  EXPECT_TRUE(inplace.EqMatrix(symmetric));
+  inplace.SubMatrix(inplace.T());
+  EXPECT_TRUE(inplace.EqMatrix(S21Matrix(6, 6)));
+  S21Matrix corner = square.Slice(0, 0, 3, 3) - square.Slice(3, 3, 3, 3);
+  EXPECT_DOUBLE_EQ(corner(2, 1), square(2, 1) - square(5, 4));
+  EXPECT_THROW(square.SumMatrix(matrix1.T()), std::out_of_range);
+}
+
+template <typename A, typename B, typename = void>
+struct CanMultiply : std::false_type {};
+
+template <typename A, typename B>
+struct CanMultiply<A, B,
+                   std::void_t<decltype(std::declval<A>() * std::declval<B>())>>
+    : std::true_type {};
+
+TEST(FixedMatrix, ConstexprOperations) {
+  constexpr S21FixedMatrix<2, 2> matrix1{1.1, 3.5, -2, 4};
+  static_assert(matrix1.GetRows() == 2 && matrix1.GetCols() == 2);
+  constexpr S21FixedMatrix<3, 3> matrix2{2, 6, 5, 5, 3, -2, 7, 4, -3};
+  static_assert(matrix2.Determinant() == -1);
+  constexpr S21FixedMatrix<3, 3> inverse{1, -38, 27, -1, 41, -29, 1, -34, 24};
+  static_assert(matrix2.InverseMatrix() == inverse);
+  constexpr S21FixedMatrix<2, 3> matrix3{1, 2, 3, 4, 5, 6};
+  constexpr S21FixedMatrix<3, 2> transposed{1, 4, 2, 5, 3, 6};
+  static_assert(matrix3.Transpose() == transposed);
+  constexpr S21FixedMatrix<2, 2> product{14, 32, 32, 77};
+  static_assert(matrix3 * transposed == product);
+  static_assert((product - product * 2.0 + product).EqMatrix({}));
+  EXPECT_DOUBLE_EQ(matrix1.Determinant(), 11.4);
+
+  static_assert(CanMultiply<S21FixedMatrix<2, 3>, S21FixedMatrix<3, 4>>());
+  static_assert(!CanMultiply<S21FixedMatrix<2, 3>, S21FixedMatrix<2, 3>>());
+}
+
+TEST(FixedMatrix, UnrolledAndGeneralSizes) {
+  S21FixedMatrix<4, 4> matrix1{9, 2, 2, 4, 3, 4, 4, 4, 4, 4, 9, 9, 1, 1, 5, 1};
+  EXPECT_DOUBLE_EQ(matrix1.Determinant(), -578);
+  S21FixedMatrix<4, 4> identity4{1, 0, 0, 0, 0, 1, 0, 0,
+                                 0, 0, 1, 0, 0, 0, 0, 1};
+  EXPECT_TRUE((matrix1 * matrix1.InverseMatrix()).EqMatrix(identity4));
+  EXPECT_TRUE((matrix1.InverseMatrix() * matrix1).EqMatrix(identity4));
+
+  S21Matrix dynamic(5, 5);
+  FillPattern(dynamic, 9);
+  for (int i = 0; i < 5; i++) dynamic(i, i) += 4;
+  S21FixedMatrix<5, 5> matrix2(dynamic);
+  EXPECT_NEAR(matrix2.Determinant(), dynamic.Determinant(), 1e-9);
+  EXPECT_TRUE(matrix2.InverseMatrix().ToMatrix().EqMatrix(
+      dynamic.InverseMatrix()));
+  EXPECT_TRUE(matrix2.ToMatrix().EqMatrix(dynamic));
+
+  S21FixedMatrix<3, 3> singular{1, 4, 1, 3, 7, 2, 3, 2, 1};
+  EXPECT_THROW(singular.InverseMatrix(), std::out_of_range);
+  S21FixedMatrix<5, 5> zero;
+  EXPECT_THROW(zero.InverseMatrix(), std::out_of_range);
+  EXPECT_THROW((S21FixedMatrix<4, 5>(dynamic)), std::out_of_range);
+  EXPECT_THROW(singular(3, 0), std::out_of_range);
+}
+
+// Keeps roughly one element in ten of FillPattern.
+static S21Matrix SparsePattern(int rows, int cols, int seed) {
+  S21Matrix matrix(rows, cols);
+  FillPattern(matrix, seed);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) {
+      if ((i * 7 + j * 3 + seed) % 10 != 0) matrix(i, j) = 0;
+    }
+  }
+  return matrix;
+}
+
+TEST(Sparse, Conversions) {
+  S21Matrix dense(3, 4);
+  dense(0, 1) = 2;
+  dense(1, 3) = 1e-9;
+  dense(2, 0) = -5;
+  dense(2, 2) = 0.5;
+  S21SparseMatrix csr(dense, 1e-6);
+  EXPECT_EQ(csr.GetNonZeros(), 3);
+  EXPECT_EQ(csr(0, 1), 2);
+  EXPECT_EQ(csr(1, 3), 0);
+  S21SparseMatrix csc = csr.ToFormat(S21SparseFormat::kCsc);
+  EXPECT_EQ(csc.GetFormat(), S21SparseFormat::kCsc);
+  EXPECT_EQ(csc(2, 0), -5);
+  EXPECT_TRUE(csc.ToDense().EqMatrix(dense));
+  EXPECT_TRUE(S21SparseMatrix(dense).ToDense() == dense);
+
+  std::vector<S21Triplet> entries = {
+      {2, 2, 0.25}, {0, 1, 2}, {2, 0, -5}, {2, 2, 0.25}};
+  S21SparseMatrix built(3, 4, entries, S21SparseFormat::kCsc);
+  EXPECT_TRUE(built == csr);
+  EXPECT_EQ(built.GetNonZeros(), 3);
+  std::vector<S21Triplet> outside = {{3, 0, 1}};
+  EXPECT_THROW(S21SparseMatrix(3, 4, outside), std::out_of_range);
+  EXPECT_THROW(S21SparseMatrix(0, 4), std::out_of_range);
+  EXPECT_THROW(csr(0, 4), std::out_of_range);
+
+  dense(1, 1) = std::nan("");
+  dense(1, 2) = -HUGE_VAL;
+  S21SparseMatrix non_finite(dense, 1e-6);
+  EXPECT_EQ(non_finite.GetNonZeros(), 5);
+  EXPECT_TRUE(std::isnan(non_finite.ToDense()(1, 1)));
+  EXPECT_EQ(non_finite(1, 2), -HUGE_VAL);
+}
+
+TEST(Sparse, Arithmetic) {
+  S21Matrix a = SparsePattern(30, 40, 1);
+  S21Matrix b = SparsePattern(30, 40, 2);
+  S21SparseMatrix sa(a);
+  S21SparseMatrix sb(b, 0, S21SparseFormat::kCsc);
+  EXPECT_TRUE((sa + sb).ToDense().EqMatrix(a + b));
+  EXPECT_TRUE((sb - sa).ToDense().EqMatrix(b - a));
+  EXPECT_TRUE((sa * 3.0).ToDense().EqMatrix(a * 3.0));
+  S21SparseMatrix zero = sa - sa;
+  EXPECT_EQ(zero.GetNonZeros(), 0);
+  EXPECT_TRUE(zero == S21SparseMatrix(30, 40));
+  EXPECT_FALSE(sa == sb);
+  EXPECT_THROW(sa += S21SparseMatrix(40, 30), std::out_of_range);
+}
+
+TEST(Sparse, Products) {
+  S21Matrix a = SparsePattern(300, 250, 3);
+  S21Matrix b = SparsePattern(250, 280, 4);
+  S21Matrix dense(250, 20);
+  S21Matrix left(20, 300);
+  FillPattern(dense, 5);
+  FillPattern(left, 6);
+  S21Matrix expected = NaiveProduct(a, b);
+  S21Matrix::SetThreadCount(4);
+  for (S21SparseFormat format :
+       {S21SparseFormat::kCsr, S21SparseFormat::kCsc}) {
+    S21SparseMatrix sa(a, 0, format);
+    S21SparseMatrix sb(b);
+    EXPECT_TRUE((sa * sb).ToDense().EqMatrix(expected));
+    EXPECT_TRUE((sa * dense).EqMatrix(NaiveProduct(a, dense)));
+    EXPECT_TRUE((left * sa).EqMatrix(NaiveProduct(left, a)));
+    std::vector<double> x(250);
+    for (int i = 0; i < 250; i++) x[i] = (i % 9) - 4.0;
+    std::vector<double> y = sa * x;
+    for (int i = 0; i < 300; i++) {
+      double sum = 0;
+      for (int j = 0; j < 250; j++) sum += a(i, j) * x[j];
+      EXPECT_NEAR(y[i], sum, 1e-9);
+    }
+  }
+  S21Matrix::SetThreadCount(0);
+  S21SparseMatrix sa(a);
+  EXPECT_THROW(sa * sa, std::out_of_range);
+  EXPECT_THROW(sa * std::vector<double>(3), std::out_of_range);
+  EXPECT_THROW(sa * a, std::out_of_range);
+}
+
+template <typename Matrix, typename = void>
+struct CanSave : std::false_type {};
+
+template <typename Matrix>
+struct CanSave<Matrix, std::void_t<decltype(std::declval<const Matrix &>()
+                                                .Save(std::string()))>>
+    : std::true_type {};
+
+TEST(Files, SaveAndMap) {
+  static_assert(CanSave<S21Matrix>());
+  static_assert(!CanSave<S21BasicMatrix<float>>());
+  static_assert(!CanSave<S21BasicMatrix<long double>>());
+  S21Matrix matrix(37, 21);
+  FillPattern(matrix, 4);
+  matrix.Save("s21_matrix_test.bin");
+  {
+    S21MappedMatrix mapped = S21Matrix::MapFile("s21_matrix_test.bin", true);
+    EXPECT_EQ(mapped.GetRows(), 37);
+    EXPECT_EQ(mapped.GetCols(), 21);
+    EXPECT_EQ(mapped(36, 20), matrix(36, 20));
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&mapped(1, 0)) % 64, 0u);
+    EXPECT_TRUE(matrix.EqMatrix(mapped));
+    S21Matrix copy(mapped.View().T());
+    EXPECT_TRUE(copy.EqMatrix(matrix.Transpose()));
+    EXPECT_THROW(mapped(37, 0), std::out_of_range);
+  }
+  // A square matrix transposed in place is saved from a dense stride.
+  S21Matrix square(9, 9);
+  FillPattern(square, 5);
+  square.TransposeInPlace();
+  square.Save("s21_matrix_test.bin");
+  EXPECT_TRUE(square.EqMatrix(S21Matrix::MapFile("s21_matrix_test.bin")));
+
+  std::fstream file("s21_matrix_test.bin",
+                    std::ios::binary | std::ios::in | std::ios::out);
+  file.seekp(sizeof(S21FileHeader) + 8);
+  file.put(42);
+  file.close();
+  EXPECT_NO_THROW(S21Matrix::MapFile("s21_matrix_test.bin"));
+  EXPECT_THROW(S21Matrix::MapFile("s21_matrix_test.bin", true),
+               std::runtime_error);
+  std::ofstream("s21_matrix_test.bin") << "not a matrix";
+  EXPECT_THROW(S21Matrix::MapFile("s21_matrix_test.bin"), std::runtime_error);
+  std::remove("s21_matrix_test.bin");
+  EXPECT_THROW(S21Matrix::MapFile("s21_matrix_test.bin"), std::runtime_error);
+}
+
+TEST(Files, MulFiles) {
+  S21Matrix lhs(70, 45);
+  S21Matrix rhs(45, 93);
+  FillPattern(lhs, 6);
+  FillPattern(rhs, 7);
+  lhs.Save("s21_matrix_lhs.bin");
+  rhs.Save("s21_matrix_rhs.bin");
+  // Room for 16 x 16 tiles only, so every edge is partial somewhere.
+  const std::size_t memory = 6 * 16 * 16 * sizeof(double);
+  EXPECT_EQ(s21::OutOfCoreTile(memory), 16);
+  S21Matrix::MulFiles("s21_matrix_lhs.bin", "s21_matrix_rhs.bin",
+                      "s21_matrix_result.bin", memory);
+  S21MappedMatrix result = S21Matrix::MapFile("s21_matrix_result.bin", true);
+  EXPECT_EQ(result.GetRows(), 70);
+  EXPECT_EQ(result.GetCols(), 93);
+  EXPECT_TRUE(NaiveProduct(lhs, rhs).EqMatrix(result));
+  EXPECT_THROW(S21Matrix::MulFiles("s21_matrix_lhs.bin", "s21_matrix_lhs.bin",
+                                   "s21_matrix_result.bin", memory),
+               std::out_of_range);
+  // Writing over an input is refused before anything is truncated.
+  S21Matrix square(45, 45);
+  FillPattern(square, 8);
+  square.Save("s21_matrix_lhs.bin");
+  EXPECT_THROW(S21Matrix::MulFiles("s21_matrix_lhs.bin", "s21_matrix_rhs.bin",
+                                   "./s21_matrix_lhs.bin", memory),
+               std::runtime_error);
+  EXPECT_THROW(S21Matrix::MulFiles("s21_matrix_lhs.bin", "s21_matrix_rhs.bin",
+                                   "s21_matrix_rhs.bin", memory),
+               std::runtime_error);
+  EXPECT_TRUE(square.EqMatrix(S21Matrix::MapFile("s21_matrix_lhs.bin", true)));
+  std::remove("s21_matrix_lhs.bin");
+  std::remove("s21_matrix_rhs.bin");
+  std::remove("s21_matrix_result.bin");
+}
+
+TEST(Instrument, Counters) {
+  s21::ResetCounters();
+  {
+    S21Matrix matrix(8, 8);
+    FillPattern(matrix, 3);
+    S21Matrix copy(matrix);
+    copy.MulMatrix(matrix);
+    copy.SumMatrix(matrix);
+  }
+  s21::CounterSnapshot snapshot = s21::ReadCounters();
+  const s21::OpCounters &mul = snapshot.ops[int(s21::MatrixOp::kMulMatrix)];
+  if (!s21::kCountersEnabled) {
+    EXPECT_EQ(mul.calls, 0u);
+    EXPECT_EQ(snapshot.allocations, 0u);
+    return;
+  }
+  EXPECT_EQ(mul.calls, 1u);
+  EXPECT_EQ(mul.flops, 2u * 8 * 8 * 8);
+  EXPECT_EQ(snapshot.ops[int(s21::MatrixOp::kSum)].calls, 1u);
+  EXPECT_EQ(snapshot.ops[int(s21::MatrixOp::kCopy)].calls, 1u);
+  EXPECT_EQ(snapshot.elements_copied, 64u);
+  // matrix, copy and the product buffer, all released again.
+  EXPECT_EQ(snapshot.allocations, 3u);
+  EXPECT_EQ(snapshot.frees, 3u);
+  EXPECT_EQ(snapshot.bytes_allocated, 3u * 64 * sizeof(double));
+  EXPECT_EQ(snapshot.bytes_freed, snapshot.bytes_allocated);
+
+  // The operators that skip the member functions count as well.
+  s21::ResetCounters();
+  {
+    S21Matrix lhs(4, 6);
+    S21Matrix rhs(6, 5);
+    S21Matrix product = lhs * rhs;
+    S21Matrix difference = product - S21Matrix(4, 5);
+  }
+  snapshot = s21::ReadCounters();
+  EXPECT_EQ(mul.calls, 1u);
+  EXPECT_EQ(mul.flops, 2u * 4 * 6 * 5);
+  EXPECT_EQ(snapshot.ops[int(s21::MatrixOp::kSub)].calls, 1u);
+  EXPECT_EQ(snapshot.ops[int(s21::MatrixOp::kSub)].flops, 20u);
+
+  // Counts from pool workers are merged in, also after they exit.
+  S21Matrix::SetThreadCount(4);
+  s21::ThreadPool::Instance().ParallelFor(8, [](int) {
+    S21Matrix local(2, 2);
+    local.MulNumber(2);
+  });
+  S21Matrix::SetThreadCount(0);
+  snapshot = s21::ReadCounters();
+  EXPECT_EQ(snapshot.ops[int(s21::MatrixOp::kMulNumber)].calls, 8u);
+  EXPECT_NE(s21::CountersToJson(snapshot).find("\"mul_matrix\": {\"calls\": 1"),
+            std::string::npos);
+  EXPECT_NE(s21::CountersToPrometheus(snapshot).find(
+                "s21_matrix_op_calls_total{op=\"mul_number\"} 8"),
+            std::string::npos);
+}
+
+TEST(Instrument, CachedFactorsCostNothing) {
+  S21Matrix matrix(6, 6);
+  FillPattern(matrix, 2);
+  for (int i = 0; i < 6; i++) matrix(i, i) += 6;
+  s21::ResetCounters();
+  matrix.Determinant();
+  matrix.Determinant();
+  matrix.InverseMatrix();
+  matrix.InverseMatrix();
+  s21::CounterSnapshot snapshot = s21::ReadCounters();
+  if (!s21::kCountersEnabled) return;
+  const s21::OpCounters &det = snapshot.ops[int(s21::MatrixOp::kDeterminant)];
+  const s21::OpCounters &inv = snapshot.ops[int(s21::MatrixOp::kInverse)];
+  EXPECT_EQ(det.calls, 2u);
+  EXPECT_EQ(det.flops, 144u);
+  EXPECT_EQ(inv.calls, 2u);
+  EXPECT_EQ(inv.flops, 2u * 6 * 6 * 6);
+}
+
+TEST(Instrument, AppendRowsAmortized) {
+  s21::ResetCounters();
+  {
+    S21Matrix matrix(1, 16);
+    for (int rows = 2; rows <= 1024; rows++) matrix.SetRows(rows);
+    matrix.SetRows(1);
+  }
+  s21::CounterSnapshot snapshot = s21::ReadCounters();
+  if (!s21::kCountersEnabled) return;
+  // The first buffer and one per doubling up to 1024 rows.
+  EXPECT_EQ(snapshot.allocations, 11u);
+  EXPECT_EQ(snapshot.elements_copied, 16u * 1023);
+}
+
+TEST(Batch, MatchesSingleMatrices) {
+  S21Matrix::SetThreadCount(4);
+  for (int n : {4, 7, 16}) {
+    const int count = n == 4 ? 600 : 40;
+    S21MatrixBatch lhs(count, n, n);
+    S21MatrixBatch rhs(count, n, n);
+    for (int index = 0; index < count; index++) {
+      S21Matrix matrix(n, n);
+      FillPattern(matrix, index);
+      for (int i = 0; i < n; i++) matrix(i, (i + index) % n) += 2;
+      lhs.Set(index, matrix);
+      FillPattern(matrix, index + 1);
+      rhs.Set(index, matrix);
+    }
+    S21MatrixBatch product = lhs * rhs;
+    S21MatrixBatch inverse = lhs.InverseMatrix();
+    S21MatrixBatch sum = lhs + rhs;
+    S21MatrixBatch transposed = rhs.Transpose();
+    std::vector<double> determ = lhs.Determinant();
+    for (int index = 0; index < count; index += 13) {
+      S21Matrix a = lhs.Get(index);
+      S21Matrix b = rhs.Get(index);
+      EXPECT_TRUE(product.Get(index).EqMatrix(a * b));
+      EXPECT_TRUE(inverse.Get(index).EqMatrix(a.InverseMatrix()));
+      EXPECT_TRUE(sum.Get(index).EqMatrix(a + b));
+      EXPECT_TRUE(transposed.Get(index).EqMatrix(b.Transpose()));
+      EXPECT_NEAR(determ[index], a.Determinant(),
+                  1e-9 * std::fabs(a.Determinant()));
+    }
+    EXPECT_TRUE((lhs * 2.0 - lhs) == lhs);
+  }
+  S21Matrix::SetThreadCount(0);
+
+  S21MatrixBatch batch(3, 2, 3);
+  batch(1, 0, 2) = 5;
+  EXPECT_EQ(batch.Get(1)(0, 2), 5);
+  EXPECT_THROW(batch.InverseMatrix(), std::out_of_range);
+  EXPECT_THROW(batch.MulMatrix(batch), std::out_of_range);
+  EXPECT_THROW(batch.Set(3, S21Matrix(2, 3)), std::out_of_range);
+  EXPECT_THROW(batch.Set(0, S21Matrix(3, 2)), std::out_of_range);
+  S21MatrixBatch square(3, 2, 2);
+  square(0, 0, 0) = square(0, 1, 1) = 1;
+  EXPECT_THROW(square.InverseMatrix(), std::out_of_range);
+  EXPECT_EQ(square.Determinant()[0], 1);
+  EXPECT_EQ(square.Determinant()[2], 0);
+
+  // Singular only up to rounding, badly scaled but regular, and the
+  // identity: the same verdicts as S21Matrix.
+  S21MatrixBatch slices(3, 3, 3);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) slices(0, i, j) = i * 3 + j + 1;
+    slices(1, i, i) = slices(2, i, i) = 1;
+  }
+  slices(1, 0, 0) = 1e16;
+  slices(1, 0, 1) = 1;
+  std::vector<double> slice_determ = slices.Determinant();
+  EXPECT_EQ(slice_determ[0], 0);
+  EXPECT_DOUBLE_EQ(slice_determ[1], 1e16);
+  EXPECT_EQ(slice_determ[2], 1);
+  EXPECT_THROW(slices.InverseMatrix(), std::out_of_range);
+  slices.Set(0, slices.Get(2));
+  S21MatrixBatch slice_inverse = slices.InverseMatrix();
+  S21Matrix scaled = slices.Get(1);
+  EXPECT_TRUE(slice_inverse.Get(1).EqMatrix(scaled.InverseMatrix()));
+}
+
+template <typename Scalar, typename From>
+static S21BasicMatrix<Scalar> Converted(const S21BasicMatrix<From> &matrix) {
+  S21BasicMatrix<Scalar> result(matrix.GetRows(), matrix.GetCols());
+  for (int i = 0; i < matrix.GetRows(); i++) {
+    for (int j = 0; j < matrix.GetCols(); j++) result(i, j) = matrix(i, j);
+  }
+  return result;
+}
+
+// Pattern elements are multiples of 1 / 8, so these products are exact in
+// every element type and must match the double results.
+template <typename Scalar>
+static void ExpectMatchesDouble() {
+  S21Matrix a(70, 90), b(90, 50), c(5, 5);
+  FillPattern(a, 1);
+  FillPattern(b, 2);
+  FillPattern(c, 3);
+  S21BasicMatrix<Scalar> x = Converted<Scalar>(a);
+  S21BasicMatrix<Scalar> y = Converted<Scalar>(b);
+  EXPECT_TRUE((x * y).EqMatrix(Converted<Scalar>(NaiveProduct(a, b))));
+  EXPECT_TRUE((x.T() * x).EqMatrix(Converted<Scalar>(a.T() * a)));
+  EXPECT_TRUE((x + x).EqMatrix(x * Scalar(2)));
+  S21BasicMatrix<Scalar> transposed = x.Transpose();
+  x.TransposeInPlace();
+  EXPECT_TRUE(x == transposed);
+  EXPECT_TRUE(Converted<Scalar>(c).CalcComplements().EqMatrix(
+      Converted<Scalar>(c.CalcComplements())));
+
+  const int n = 40;
+  S21BasicMatrix<Scalar> dominant(n, n), identity(n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) dominant(i, j) = Scalar((i * 7 + j * 3) % 11);
+    dominant(i, i) += 10 * n;
+    identity(i, i) = 1;
+  }
+  EXPECT_TRUE((dominant * dominant.InverseMatrix()).EqMatrix(identity));
+  // A corner keeps the determinant within float range.
+  S21BasicMatrix<Scalar> corner(dominant.Slice(0, 0, 8, 8));
+  const double determ = Converted<double>(corner).Determinant();
+  EXPECT_NEAR(double(corner.Determinant()) / determ, 1, 1e-5);
+}
+
+TEST(ElementTypes, Tolerance) {
+  S21BasicMatrix<float> f1(2, 2), f2(2, 2);
+  f2(1, 1) = 5e-4f;
+  EXPECT_TRUE(f1.EqMatrix(f2));
+  f2(1, 1) = 5e-3f;
+  EXPECT_FALSE(f1.EqMatrix(f2));
+  S21Matrix d1(2, 2), d2(2, 2);
+  d2(1, 1) = 5e-8;
+  EXPECT_TRUE(d1.EqMatrix(d2));
+  d2(1, 1) = 5e-4;
+  EXPECT_FALSE(d1.EqMatrix(d2));
+  S21BasicMatrix<long double> l1(2, 2), l2(2, 2);
+  l2(1, 1) = 5e-10L;
+  EXPECT_TRUE(l1.EqMatrix(l2));
+  l2(1, 1) = 5e-8L;
+  EXPECT_FALSE(l1.EqMatrix(l2));
+}
+
+TEST(ElementTypes, MatchDouble) {
+  ExpectMatchesDouble<float>();
+  ExpectMatchesDouble<long double>();
+}
+
+TEST(ElementTypes, LongDoubleKeepsDigits) {
+  // 1 + 1e-17 rounds to 1 in double, so only long double sees a nonzero
+  // determinant.
+  S21BasicMatrix<long double> matrix(3, 3);
+  matrix(0, 0) = matrix(0, 1) = matrix(1, 0) = matrix(2, 2) = 1;
+  matrix(1, 1) = 1 + 1e-17L;
+  EXPECT_NEAR(double(matrix.Determinant()), 1e-17, 1e-19);
+  S21Matrix rounded(3, 3);
+  rounded(0, 0) = rounded(0, 1) = rounded(1, 0) = rounded(2, 2) = 1;
+  rounded(1, 1) = 1 + 1e-17;
+  EXPECT_EQ(rounded.Determinant(), 0);
+}
+
+// B * B^T / n + I, symmetric positive definite with eigenvalues of at least
+// one, so determinants stay in range.
+static S21Matrix SpdPattern(int n, int seed) {
+  S21Matrix b(n, n);
+  FillPattern(b, seed);
+  S21Matrix a = b * b.Transpose();
+  a.MulNumber(1.0 / n);
+  for (int i = 0; i < n; i++) a(i, i) += 1;
+  return a;
+}
+
+TEST(Symmetric, IsSymmetric) {
+  S21Matrix matrix = SpdPattern(40, 1);
+  EXPECT_TRUE(matrix.IsSymmetric());
+  matrix(3, 30) += 1e-9;
+  EXPECT_TRUE(matrix.IsSymmetric());
+  EXPECT_FALSE(matrix.IsSymmetric(0));
+  matrix(30, 3) += 1;
+  EXPECT_FALSE(matrix.IsSymmetric());
+  EXPECT_FALSE(S21Matrix(3, 4).IsSymmetric());
+}
+
+TEST(Symmetric, Cholesky) {
+  S21Matrix matrix = SpdPattern(100, 2);
+  S21Matrix lower = matrix.Cholesky();
+  for (int i = 0; i < 100; i++) {
+    for (int j = i + 1; j < 100; j++) EXPECT_EQ(lower(i, j), 0);
+  }
+  EXPECT_TRUE((lower * lower.T()).EqMatrix(matrix));
+
+  // Symmetric but indefinite: kAuto falls back to LU, kCholesky refuses.
+  S21Matrix indefinite(3, 3);
+  indefinite(0, 1) = indefinite(1, 0) = 2;
+  indefinite(2, 2) = 3;
+  EXPECT_THROW(indefinite.Cholesky(), std::out_of_range);
+  EXPECT_THROW(S21Matrix(indefinite).Determinant(S21Factorization::kCholesky),
+               std::out_of_range);
+  EXPECT_DOUBLE_EQ(indefinite.Determinant(), -12);
+  EXPECT_THROW(S21Matrix(2, 3).Cholesky(), std::out_of_range);
+}
+
+TEST(Symmetric, FactorizationsAgree) {
+  // Spans several Cholesky blocks; the four threads split both the panel
+  // rows and the trailing update.
+  const int n = 150;
+  S21Matrix::SetThreadCount(4);
+  S21Matrix matrix1 = SpdPattern(n, 3);
+  S21Matrix matrix2(matrix1);
+  S21Matrix rhs(n, 20);
+  FillPattern(rhs, 5);
+  EXPECT_NEAR(matrix1.Determinant() /
+                  matrix2.Determinant(S21Factorization::kLU),
+              1, 1e-9);
+  S21Matrix inverse = matrix1.InverseMatrix();
+  EXPECT_TRUE(inverse.IsSymmetric(0));
+  EXPECT_TRUE(inverse.EqMatrix(matrix2.InverseMatrix()));
+  EXPECT_TRUE(matrix1.Solve(rhs).EqMatrix(matrix2.Solve(rhs)));
+  EXPECT_TRUE((matrix1 * matrix1.Solve(rhs)).EqMatrix(rhs));
+  S21Matrix::SetThreadCount(0);
+}
+
+// A weighted path Laplacian, rows and columns rescaled: positive
+// semidefinite with rank n - 1. At these sizes Cholesky gets through with a
+// last pivot of rounding size, which has to count as zero.
+TEST(Symmetric, RankDeficient) {
+  for (int seed : {0, 1, 3, 5}) {
+    const int n = 5 + seed * 3;
+    S21Matrix matrix(n, n);
+    for (int i = 0; i + 1 < n; i++) {
+      const double w = 1 + 0.5 * std::sin(i * 1.3 + seed);
+      matrix(i, i) += w;
+      matrix(i + 1, i + 1) += w;
+      matrix(i, i + 1) -= w;
+      matrix(i + 1, i) -= w;
+    }
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < n; j++) {
+        matrix(i, j) *= (1 + 0.3 * std::cos(i + seed)) *
+                        (1 + 0.3 * std::cos(j + seed));
+      }
+    }
+    ASSERT_NO_THROW(matrix.Cholesky());
+    S21Matrix matrix_lu(matrix);
+    S21Matrix rhs(n, 1);
+    EXPECT_EQ(matrix.Determinant(), 0);
+    EXPECT_EQ(matrix_lu.Determinant(S21Factorization::kLU), 0);
+    EXPECT_THROW(matrix.InverseMatrix(), std::out_of_range);
+    EXPECT_THROW(matrix.Solve(rhs), std::out_of_range);
+    EXPECT_THROW(matrix_lu.InverseMatrix(), std::out_of_range);
+    S21SymmetricMatrix packed(matrix);
+    EXPECT_EQ(packed.Determinant(), 0);
+    EXPECT_THROW(packed.InverseMatrix(), std::out_of_range);
+    EXPECT_THROW(packed.Solve(rhs), std::out_of_range);
+  }
+}
+
+// Within the IsSymmetric() tolerance but not symmetric: kAuto has to give
+// the LU answer for the whole matrix, not the one for its lower triangle.
+TEST(Symmetric, NearlySymmetricUsesLU) {
+  S21Matrix tiny(3, 3);
+  const double values[] = {4, 1, 0, 3, 4, 1, 0, 2, 4};
+  for (int i = 0; i < 9; i++) tiny(i / 3, i % 3) = values[i] * 1e-9;
+  S21Matrix tiny_lu(tiny);
+  EXPECT_NEAR(tiny.Determinant() / tiny_lu.Determinant(S21Factorization::kLU),
+              1, 1e-12);
+
+  const int n = 30;
+  S21Matrix matrix = SpdPattern(n, 7);
+  matrix(0, 1) += 1e-8;
+  ASSERT_TRUE(matrix.IsSymmetric());
+  S21Matrix matrix_lu(matrix);
+  S21Matrix rhs(n, 3);
+  FillPattern(rhs, 8);
+  S21Matrix inverse = matrix.InverseMatrix();
+  S21Matrix inverse_lu = matrix_lu.InverseMatrix(S21Factorization::kLU);
+  S21Matrix solution = matrix.Solve(rhs);
+  S21Matrix solution_lu = matrix_lu.Solve(rhs);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      EXPECT_NEAR(inverse(i, j), inverse_lu(i, j), 1e-13);
+    }
+    for (int j = 0; j < 3; j++) {
+      EXPECT_NEAR(solution(i, j), solution_lu(i, j), 1e-13);
+    }
+  }
+}
+
+TEST(Symmetric, Packed) {
+  const int n = 90;
+  S21Matrix dense = SpdPattern(n, 4);
+  S21SymmetricMatrix packed(dense);
+  EXPECT_EQ(packed.GetRows(), n);
+  EXPECT_EQ(packed.GetCols(), n);
+  EXPECT_TRUE(packed.ToDense().EqMatrix(dense));
+  packed(2, 70) = 5;
+  EXPECT_EQ(packed(70, 2), 5);
+  packed(70, 2) = dense(2, 70);
+
+  S21Matrix rhs(n, 7);
+  FillPattern(rhs, 6);
+  S21Matrix::SetThreadCount(4);
+  EXPECT_NEAR(packed.Determinant() / dense.Determinant(), 1, 1e-9);
+  S21Matrix::SetThreadCount(0);
+  EXPECT_TRUE(packed.InverseMatrix().ToDense().EqMatrix(dense.InverseMatrix()));
+  EXPECT_TRUE(packed.Solve(rhs).EqMatrix(dense.Solve(rhs)));
+
+  S21SymmetricMatrix twice(packed);
+  twice.SumMatrix(packed);
+  packed.MulNumber(2);
+  EXPECT_TRUE(twice.EqMatrix(packed));
+  twice.SubMatrix(packed);
+  EXPECT_TRUE(twice.EqMatrix(S21SymmetricMatrix(n)));
+
+  S21Matrix indefinite(3, 3);
+  indefinite(0, 1) = indefinite(1, 0) = 2;
+  indefinite(2, 2) = 3;
+  S21SymmetricMatrix packed_indefinite(indefinite);
+  EXPECT_DOUBLE_EQ(packed_indefinite.Determinant(), -12);
+  EXPECT_TRUE(packed_indefinite.InverseMatrix().ToDense().EqMatrix(
+      indefinite.InverseMatrix()));
+
+  // Indefinite and small: the LU inverse is symmetric only up to rounding
+  // well above the IsSymmetric tolerance.
+  const int m = 60;
+  S21Matrix scaled(m, m);
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j <= i; j++) {
+      scaled(i, j) = ((i * 31 + j * 17 + i * j) % 23 - 11) * 1e-9;
+      scaled(j, i) = scaled(i, j);
+    }
+  }
+  S21SymmetricMatrix packed_scaled(scaled);
+  S21Matrix scaled_inverse = packed_scaled.InverseMatrix().ToDense();
+  S21Matrix identity = scaled * scaled_inverse;
+  for (int i = 0; i < m; i++) identity(i, i) -= 1;
+  EXPECT_TRUE(identity.EqMatrix(S21Matrix(m, m)));
+
+  dense(0, 1) += 1;
+  EXPECT_THROW(S21SymmetricMatrix{dense}, std::out_of_range);
+  EXPECT_THROW(S21SymmetricMatrix(0), std::out_of_range);
+  EXPECT_THROW(packed(n, 0), std::out_of_range);
+  EXPECT_THROW(packed.Solve(S21Matrix(n + 1, 1)), std::out_of_range);
+}
+
 int main(int argc, char *argv[]) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,89 @@
+#include "s21_matrix_view.h"
+
+#include <stdexcept>
+
+#include "s21_gemm.h"
+#include "s21_matrix_oop.h"
+
+template <typename Scalar>
+S21BasicMatrixView<Scalar>::S21BasicMatrixView(
+    const S21BasicMatrix<Scalar> &matrix)
+    : data_(matrix.matrix_),
+      rows_(matrix.rows_),
+      cols_(matrix.cols_),
+      row_stride_(matrix.ld_),
+      col_stride_(1) {}
+
+template <typename Scalar>
+S21BasicMatrixView<Scalar>::S21BasicMatrixView(const Scalar *data, int rows,
+                                               int cols,
+                                               std::ptrdiff_t row_stride,
+                                               std::ptrdiff_t col_stride)
+    : data_(data),
+      rows_(rows),
+      cols_(cols),
+      row_stride_(row_stride),
+      col_stride_(col_stride) {
+  if (rows < 1 || cols < 1) {
+    throw std::out_of_range("Incorrect matrix size");
+  }
+}
+
+template <typename Scalar>
+S21BasicMatrixView<Scalar> S21BasicMatrixView<Scalar>::T() const {
+  return S21BasicMatrixView(data_, cols_, rows_, col_stride_, row_stride_);
+}
+
+template <typename Scalar>
+S21BasicMatrixView<Scalar> S21BasicMatrixView<Scalar>::Slice(int row, int col,
+                                                             int rows,
+                                                             int cols) const {
+  if (row < 0 || col < 0 || rows < 1 || cols < 1 || row + rows > rows_ ||
+      col + cols > cols_) {
+    throw std::out_of_range("Incorrect Index");
+  }
+  return S21BasicMatrixView(at(row, col), rows, cols, row_stride_,
+                            col_stride_);
+}
+
+template <typename Scalar>
+const Scalar &S21BasicMatrixView<Scalar>::operator()(const int row,
+                                                     const int col) const {
+  if (rows_ <= row || cols_ <= col || row < 0 || col < 0) {
+    throw std::out_of_range("Incorrect Index");
+  }
+  return *at(row, col);
+}
+
+/** VIEW OPERATORS **/
+template <typename Scalar>
+S21BasicMatrix<Scalar> S21BasicMatrixView<Scalar>::add(
+    const S21BasicMatrixView &lhs, const S21BasicMatrixView &rhs) {
+  S21BasicMatrix<Scalar> result(lhs);
+  result.SumMatrix(rhs);
+  return result;
+}
+
+template <typename Scalar>
+S21BasicMatrix<Scalar> S21BasicMatrixView<Scalar>::subtract(
+    const S21BasicMatrixView &lhs, const S21BasicMatrixView &rhs) {
+  S21BasicMatrix<Scalar> result(lhs);
+  result.SubMatrix(rhs);
+  return result;
+}
+
+template <typename Scalar>
+S21BasicMatrix<Scalar> S21BasicMatrixView<Scalar>::multiply(
+    const S21BasicMatrixView &lhs, const S21BasicMatrixView &rhs) {
+  S21BasicMatrix<Scalar>::check_rows_cols(lhs.GetCols(), rhs.GetRows());
+  S21BasicMatrix<Scalar> result(lhs.GetRows(), rhs.GetCols());
+  s21::Gemm(lhs.GetRows(), rhs.GetCols(), lhs.GetCols(), Scalar(1),
+            lhs.Data(), lhs.GetRowStride(), lhs.GetColStride(), rhs.Data(),
+            rhs.GetRowStride(), rhs.GetColStride(), Scalar(0),
+            result.matrix_, result.ld_);
+  return result;
+}
+
+template class S21BasicMatrixView<float>;
+template class S21BasicMatrixView<double>;
+template class S21BasicMatrixView<long double>;
@@ -0,0 +1,69 @@
+#ifndef SRC_S21_MATRIX_VIEW_H_
+#define SRC_S21_MATRIX_VIEW_H_
+
+#include <cstddef>
+
+template <typename Scalar>
+class S21BasicMatrix;
+
+/*
+ * Read-only window onto elements owned by an S21BasicMatrix. Element (i, j)
+ * is data[i * row_stride + j * col_stride], so transposing or slicing a view
+ * only rewrites these fields and costs O(1). A view must not outlive the
+ * matrix it was taken from, nor a resize of that matrix.
+ */
+template <typename Scalar>
+class S21BasicMatrixView {
+ public:
+  S21BasicMatrixView(const S21BasicMatrix<Scalar> &matrix);  // NOLINT
+  S21BasicMatrixView(const Scalar *data, int rows, int cols,
+                     std::ptrdiff_t row_stride, std::ptrdiff_t col_stride);
+
+  int GetRows() const { return rows_; }
+  int GetCols() const { return cols_; }
+  std::ptrdiff_t GetRowStride() const { return row_stride_; }
+  std::ptrdiff_t GetColStride() const { return col_stride_; }
+  const Scalar *Data() const { return data_; }
+
+  S21BasicMatrixView T() const;
+  S21BasicMatrixView Slice(int row, int col, int rows, int cols) const;
+
+  const Scalar &operator()(const int row, const int col) const;
+  const Scalar *at(int row, int col) const {
+    return data_ + row * row_stride_ + col * col_stride_;
+  }
+
+  // Found through either operand, so a matrix on one side converts to a view.
+  friend S21BasicMatrix<Scalar> operator+(const S21BasicMatrixView &lhs,
+                                          const S21BasicMatrixView &rhs) {
+    return add(lhs, rhs);
+  }
+  friend S21BasicMatrix<Scalar> operator-(const S21BasicMatrixView &lhs,
+                                          const S21BasicMatrixView &rhs) {
+    return subtract(lhs, rhs);
+  }
+  friend S21BasicMatrix<Scalar> operator*(const S21BasicMatrixView &lhs,
+                                          const S21BasicMatrixView &rhs) {
+    return multiply(lhs, rhs);
+  }
+
+ private:
+  const Scalar *data_;
+  int rows_, cols_;
+  std::ptrdiff_t row_stride_, col_stride_;
+
+  static S21BasicMatrix<Scalar> add(const S21BasicMatrixView &lhs,
+                                    const S21BasicMatrixView &rhs);
+  static S21BasicMatrix<Scalar> subtract(const S21BasicMatrixView &lhs,
+                                         const S21BasicMatrixView &rhs);
+  static S21BasicMatrix<Scalar> multiply(const S21BasicMatrixView &lhs,
+                                         const S21BasicMatrixView &rhs);
+};
+
+using S21MatrixView = S21BasicMatrixView<double>;
+
+extern template class S21BasicMatrixView<float>;
+extern template class S21BasicMatrixView<double>;
+extern template class S21BasicMatrixView<long double>;
+
+#endif  // SRC_S21_MATRIX_VIEW_H_
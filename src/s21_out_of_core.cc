@@ -0,0 +1,206 @@
+#include "s21_out_of_core.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+#include "s21_gemm.h"
+#include "s21_matrix_file.h"
+
+namespace s21 {
+
+namespace {
+
+// Two tiles of A, two of B and two of C are resident at a time.
+constexpr int kResidentTiles = 6;
+constexpr int kMinTile = 8;
+
+class File {
+ public:
+  File(const std::string &path, int flags)
+      : fd_(open(path.c_str(), flags, 0644)) {
+    if (fd_ < 0) throw std::runtime_error("Cannot open file");
+  }
+  File(const File &) = delete;
+  File &operator=(const File &) = delete;
+  ~File() { close(fd_); }
+
+  std::size_t Size() const {
+    struct stat status;
+    if (fstat(fd_, &status) != 0) throw std::runtime_error("Cannot read file");
+    return status.st_size;
+  }
+
+  // True if path names this open file, also through links or another
+  // spelling of the same path.
+  bool Is(const std::string &path) const {
+    struct stat mine, other;
+    if (fstat(fd_, &mine) != 0) throw std::runtime_error("Cannot read file");
+    return stat(path.c_str(), &other) == 0 && mine.st_dev == other.st_dev &&
+           mine.st_ino == other.st_ino;
+  }
+
+  void Read(void *data, std::size_t size, std::uint64_t offset) const {
+    char *bytes = static_cast<char *>(data);
+    while (size > 0) {
+      const ssize_t done = pread(fd_, bytes, size, offset);
+      if (done <= 0) throw std::runtime_error("Cannot read file");
+      bytes += done;
+      size -= done;
+      offset += done;
+    }
+  }
+
+  void Write(const void *data, std::size_t size, std::uint64_t offset) const {
+    const char *bytes = static_cast<const char *>(data);
+    while (size > 0) {
+      const ssize_t done = pwrite(fd_, bytes, size, offset);
+      if (done <= 0) throw std::runtime_error("Cannot write file");
+      bytes += done;
+      size -= done;
+      offset += done;
+    }
+  }
+
+  void Resize(std::uint64_t size) const {
+    if (ftruncate(fd_, off_t(size)) != 0) {
+      throw std::runtime_error("Cannot write file");
+    }
+  }
+
+ private:
+  int fd_;
+};
+
+S21FileHeader ReadHeader(const File &file) {
+  S21FileHeader header;
+  const std::size_t size = file.Size();
+  if (size < sizeof(header)) throw std::runtime_error("Incorrect file format");
+  file.Read(&header, sizeof(header), 0);
+  if (!ValidFileHeader(header, size)) {
+    throw std::runtime_error("Incorrect file format");
+  }
+  return header;
+}
+
+// Reads the rows x cols tile at (row, col) densely into tile.
+void ReadTile(const File &file, const S21FileHeader &header, int row, int col,
+              int rows, int cols, double *tile) {
+  for (int i = 0; i < rows; i++) {
+    const std::uint64_t element = (row + i) * header.ld + col;
+    file.Read(tile + std::ptrdiff_t(i) * cols, sizeof(double) * cols,
+              header.data_offset + sizeof(double) * element);
+  }
+}
+
+void WriteTile(const File &file, const S21FileHeader &header, int row, int col,
+               int rows, int cols, const double *tile) {
+  for (int i = 0; i < rows; i++) {
+    const std::uint64_t element = (row + i) * header.ld + col;
+    file.Write(tile + std::ptrdiff_t(i) * cols, sizeof(double) * cols,
+               header.data_offset + sizeof(double) * element);
+  }
+}
+
+}  // namespace
+
+int OutOfCoreTile(std::size_t memory_bytes) {
+  const double elements =
+      double(memory_bytes) / sizeof(double) / kResidentTiles;
+  const int tile = int(std::sqrt(elements)) / kMinTile * kMinTile;
+  return std::max(tile, kMinTile);
+}
+
+void OutOfCoreGemm(const std::string &a_path, const std::string &b_path,
+                   const std::string &c_path, std::size_t memory_bytes) {
+  File a_file(a_path, O_RDONLY);
+  File b_file(b_path, O_RDONLY);
+  const S21FileHeader a = ReadHeader(a_file);
+  const S21FileHeader b = ReadHeader(b_file);
+  if (a.cols != b.rows) {
+    throw std::out_of_range("rows and cols aren't equal");
+  }
+  const int m = int(a.rows), n = int(b.cols), k = int(a.cols);
+  S21FileHeader c = MakeFileHeader(m, n);
+  // Truncating the result must not destroy an input that is still read.
+  if (a_file.Is(c_path) || b_file.Is(c_path)) {
+    throw std::runtime_error("Result file must differ from the inputs");
+  }
+  File c_file(c_path, O_RDWR | O_CREAT | O_TRUNC);
+  c_file.Resize(c.data_offset + sizeof(double) * c.rows * c.ld);
+
+  const int tile = OutOfCoreTile(memory_bytes);
+  const std::size_t tile_size = std::size_t(tile) * tile;
+  std::vector<double> a_tiles[2], b_tiles[2], c_tiles[2];
+  for (int buffer = 0; buffer < 2; buffer++) {
+    a_tiles[buffer].resize(tile_size);
+    b_tiles[buffer].resize(tile_size);
+    c_tiles[buffer].resize(tile_size);
+  }
+
+  // Steps enumerate (output tile, depth tile) pairs in the order they are
+  // consumed, so the read for step + 1 can start before step is computed.
+  const int tiles_m = (m + tile - 1) / tile;
+  const int tiles_n = (n + tile - 1) / tile;
+  const int tiles_k = (k + tile - 1) / tile;
+  const long steps = long(tiles_m) * tiles_n * tiles_k;
+  auto read_step = [&](long step, int buffer) {
+    const int ic = int(step / tiles_k / tiles_n) * tile;
+    const int jc = int(step / tiles_k % tiles_n) * tile;
+    const int pc = int(step % tiles_k) * tile;
+    const int mc = std::min(tile, m - ic);
+    const int nc = std::min(tile, n - jc);
+    const int kc = std::min(tile, k - pc);
+    ReadTile(a_file, a, ic, pc, mc, kc, a_tiles[buffer].data());
+    ReadTile(b_file, b, pc, jc, kc, nc, b_tiles[buffer].data());
+  };
+  std::future<void> pending_read =
+      std::async(std::launch::async, read_step, 0, 0);
+  std::future<void> pending_write;
+  for (long step = 0; step < steps; step++) {
+    const int buffer = step % 2;
+    const int output = int(step / tiles_k) % 2;
+    const int ic = int(step / tiles_k / tiles_n) * tile;
+    const int jc = int(step / tiles_k % tiles_n) * tile;
+    const int pc = int(step % tiles_k) * tile;
+    const int mc = std::min(tile, m - ic);
+    const int nc = std::min(tile, n - jc);
+    const int kc = std::min(tile, k - pc);
+    pending_read.get();
+    if (step + 1 < steps) {
+      pending_read =
+          std::async(std::launch::async, read_step, step + 1, 1 - buffer);
+    }
+    Gemm(mc, nc, kc, 1.0, a_tiles[buffer].data(), kc, 1,
+         b_tiles[buffer].data(), nc, 1, pc == 0 ? 0.0 : 1.0,
+         c_tiles[output].data(), nc);
+    if (pc + kc == k) {
+      // The previous write used the other output buffer; waiting for it here
+      // keeps at most one write in flight.
+      if (pending_write.valid()) pending_write.get();
+      const double *result = c_tiles[output].data();
+      pending_write = std::async(std::launch::async, [&, ic, jc, mc, nc,
+                                                      result] {
+        WriteTile(c_file, c, ic, jc, mc, nc, result);
+      });
+    }
+  }
+  if (pending_write.valid()) pending_write.get();
+
+  std::vector<double> row(c.ld);
+  for (int i = 0; i < m; i++) {
+    const std::size_t bytes = sizeof(double) * c.ld;
+    c_file.Read(row.data(), bytes, c.data_offset + bytes * i);
+    c.checksum = Fnv1a(row.data(), bytes, c.checksum);
+  }
+  c_file.Write(&c, sizeof(c), 0);
+}
+
+}  // namespace s21
@@ -0,0 +1,26 @@
+#ifndef SRC_S21_OUT_OF_CORE_H_
+#define SRC_S21_OUT_OF_CORE_H_
+
+#include <cstddef>
+#include <string>
+
+namespace s21 {
+
+/*
+ * C = A * B for operands stored in the format of s21_matrix_file.h, with no
+ * more than about memory_bytes of them in RAM at once. C is computed one
+ * square output tile at a time by streaming matching tiles of A and B past
+ * it. The next pair of input tiles is read on another thread while Gemm
+ * works on the current pair. A finished output tile is written back while
+ * the next one is computed. c_path must not name either input; that throws
+ * before anything is written.
+ */
+void OutOfCoreGemm(const std::string &a_path, const std::string &b_path,
+                   const std::string &c_path, std::size_t memory_bytes);
+
+// Edge of the square tiles OutOfCoreGemm uses under memory_bytes.
+int OutOfCoreTile(std::size_t memory_bytes);
+
+}  // namespace s21
+
+#endif  // SRC_S21_OUT_OF_CORE_H_
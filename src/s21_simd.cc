@@ -0,0 +1,587 @@
+#include "s21_simd.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define S21_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace s21 {
+
+namespace {
+
+template <typename T>
+void AddScalar(T *a, const T *b, std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) a[i] += b[i];
+}
+
+template <typename T>
+void SubScalar(T *a, const T *b, std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) a[i] -= b[i];
+}
+
+template <typename T>
+void RsubScalar(T *a, const T *b, std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) a[i] = b[i] - a[i];
+}
+
+template <typename T>
+void ScaleScalar(T *a, T num, std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) a[i] *= num;
+}
+
+template <typename T>
+bool NearScalar(const T *a, const T *b, std::size_t n, T tolerance) {
+  for (std::size_t i = 0; i < n; i++) {
+    if (std::abs(a[i] - b[i]) > tolerance) return false;
+  }
+  return true;
+}
+
+template <typename T>
+void TransposeScalar(int rows, int cols, const T *src, std::ptrdiff_t lds,
+                     T *dst, std::ptrdiff_t ldd) {
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) dst[j * ldd + i] = src[i * lds + j];
+  }
+}
+
+// Transposes the parts of a tile left over after the first rows x cols
+// block, which the vector loops covered.
+template <typename T>
+void TransposeEdges(int rows, int cols, int done_rows, int done_cols,
+                    const T *src, std::ptrdiff_t lds, T *dst,
+                    std::ptrdiff_t ldd) {
+  TransposeScalar(rows - done_rows, cols, src + done_rows * lds, lds,
+                  dst + done_rows, ldd);
+  TransposeScalar(done_rows, cols - done_cols, src + done_cols, lds,
+                  dst + done_cols * ldd, ldd);
+}
+
+#ifdef S21_SIMD_X86
+
+void AddSse2(double *a, const double *b, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(a + i, _mm_add_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+  }
+  AddScalar(a + i, b + i, n - i);
+}
+
+void SubSse2(double *a, const double *b, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(a + i, _mm_sub_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+  }
+  SubScalar(a + i, b + i, n - i);
+}
+
+void RsubSse2(double *a, const double *b, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(a + i, _mm_sub_pd(_mm_loadu_pd(b + i), _mm_loadu_pd(a + i)));
+  }
+  RsubScalar(a + i, b + i, n - i);
+}
+
+void ScaleSse2(double *a, double num, std::size_t n) {
+  const __m128d factor = _mm_set1_pd(num);
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(a + i, _mm_mul_pd(_mm_loadu_pd(a + i), factor));
+  }
+  ScaleScalar(a + i, num, n - i);
+}
+
+bool NearSse2(const double *a, const double *b, std::size_t n,
+              double tolerance) {
+  const __m128d sign = _mm_set1_pd(-0.0);
+  const __m128d tol = _mm_set1_pd(tolerance);
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    __m128d diff = _mm_sub_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i));
+    __m128d over = _mm_cmpgt_pd(_mm_andnot_pd(sign, diff), tol);
+    if (_mm_movemask_pd(over)) return false;
+  }
+  return NearScalar(a + i, b + i, n - i, tolerance);
+}
+
+void TransposeSse2(int rows, int cols, const double *src, std::ptrdiff_t lds,
+                   double *dst, std::ptrdiff_t ldd) {
+  const int rows2 = rows & ~1;
+  const int cols2 = cols & ~1;
+  for (int i = 0; i < rows2; i += 2) {
+    for (int j = 0; j < cols2; j += 2) {
+      const double *s = src + i * lds + j;
+      __m128d r0 = _mm_loadu_pd(s);
+      __m128d r1 = _mm_loadu_pd(s + lds);
+      double *d = dst + j * ldd + i;
+      _mm_storeu_pd(d, _mm_unpacklo_pd(r0, r1));
+      _mm_storeu_pd(d + ldd, _mm_unpackhi_pd(r0, r1));
+    }
+  }
+  TransposeEdges(rows, cols, rows2, cols2, src, lds, dst, ldd);
+}
+
+__attribute__((target("avx2"))) void AddAvx2(double *a, const double *b,
+                                             std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(a + i, _mm256_add_pd(_mm256_loadu_pd(a + i),
+                                          _mm256_loadu_pd(b + i)));
+  }
+  AddScalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("avx2"))) void SubAvx2(double *a, const double *b,
+                                             std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(a + i, _mm256_sub_pd(_mm256_loadu_pd(a + i),
+                                          _mm256_loadu_pd(b + i)));
+  }
+  SubScalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("avx2"))) void RsubAvx2(double *a, const double *b,
+                                              std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(a + i, _mm256_sub_pd(_mm256_loadu_pd(b + i),
+                                          _mm256_loadu_pd(a + i)));
+  }
+  RsubScalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("avx2"))) void ScaleAvx2(double *a, double num,
+                                               std::size_t n) {
+  const __m256d factor = _mm256_set1_pd(num);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(a + i, _mm256_mul_pd(_mm256_loadu_pd(a + i), factor));
+  }
+  ScaleScalar(a + i, num, n - i);
+}
+
+__attribute__((target("avx2"))) bool NearAvx2(const double *a,
+                                              const double *b, std::size_t n,
+                                              double tolerance) {
+  const __m256d sign = _mm256_set1_pd(-0.0);
+  const __m256d tol = _mm256_set1_pd(tolerance);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256d diff =
+        _mm256_sub_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i));
+    __m256d over =
+        _mm256_cmp_pd(_mm256_andnot_pd(sign, diff), tol, _CMP_GT_OQ);
+    if (_mm256_movemask_pd(over)) return false;
+  }
+  return NearScalar(a + i, b + i, n - i, tolerance);
+}
+
+__attribute__((target("avx2"))) void TransposeAvx2(int rows, int cols,
+                                                   const double *src,
+                                                   std::ptrdiff_t lds,
+                                                   double *dst,
+                                                   std::ptrdiff_t ldd) {
+  const int rows4 = rows & ~3;
+  const int cols4 = cols & ~3;
+  for (int i = 0; i < rows4; i += 4) {
+    for (int j = 0; j < cols4; j += 4) {
+      const double *s = src + i * lds + j;
+      __m256d t0 = _mm256_loadu_pd(s);
+      __m256d t1 = _mm256_loadu_pd(s + lds);
+      __m256d t2 = _mm256_loadu_pd(s + 2 * lds);
+      __m256d t3 = _mm256_loadu_pd(s + 3 * lds);
+      __m256d u0 = _mm256_unpacklo_pd(t0, t1);
+      __m256d u1 = _mm256_unpackhi_pd(t0, t1);
+      __m256d u2 = _mm256_unpacklo_pd(t2, t3);
+      __m256d u3 = _mm256_unpackhi_pd(t2, t3);
+      double *d = dst + j * ldd + i;
+      _mm256_storeu_pd(d, _mm256_permute2f128_pd(u0, u2, 0x20));
+      _mm256_storeu_pd(d + ldd, _mm256_permute2f128_pd(u1, u3, 0x20));
+      _mm256_storeu_pd(d + 2 * ldd, _mm256_permute2f128_pd(u0, u2, 0x31));
+      _mm256_storeu_pd(d + 3 * ldd, _mm256_permute2f128_pd(u1, u3, 0x31));
+    }
+  }
+  TransposeEdges(rows, cols, rows4, cols4, src, lds, dst, ldd);
+}
+
+__attribute__((target("avx512f"))) void AddAvx512(double *a, const double *b,
+                                                  std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm512_storeu_pd(a + i, _mm512_add_pd(_mm512_loadu_pd(a + i),
+                                          _mm512_loadu_pd(b + i)));
+  }
+  AddScalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("avx512f"))) void SubAvx512(double *a, const double *b,
+                                                  std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm512_storeu_pd(a + i, _mm512_sub_pd(_mm512_loadu_pd(a + i),
+                                          _mm512_loadu_pd(b + i)));
+  }
+  SubScalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("avx512f"))) void RsubAvx512(double *a,
+                                                   const double *b,
+                                                   std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm512_storeu_pd(a + i, _mm512_sub_pd(_mm512_loadu_pd(b + i),
+                                          _mm512_loadu_pd(a + i)));
+  }
+  RsubScalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("avx512f"))) void ScaleAvx512(double *a, double num,
+                                                    std::size_t n) {
+  const __m512d factor = _mm512_set1_pd(num);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm512_storeu_pd(a + i, _mm512_mul_pd(_mm512_loadu_pd(a + i), factor));
+  }
+  ScaleScalar(a + i, num, n - i);
+}
+
+__attribute__((target("avx512f"))) bool NearAvx512(const double *a,
+                                                   const double *b,
+                                                   std::size_t n,
+                                                   double tolerance) {
+  const __m512d tol = _mm512_set1_pd(tolerance);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m512d diff =
+        _mm512_sub_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i));
+    if (_mm512_cmp_pd_mask(_mm512_abs_pd(diff), tol, _CMP_GT_OQ)) {
+      return false;
+    }
+  }
+  return NearScalar(a + i, b + i, n - i, tolerance);
+}
+
+// Single precision: the same kernels with twice as many lanes per register.
+
+void AddSse2(float *a, const float *b, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(a + i, _mm_add_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+  }
+  AddScalar(a + i, b + i, n - i);
+}
+
+void SubSse2(float *a, const float *b, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(a + i, _mm_sub_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+  }
+  SubScalar(a + i, b + i, n - i);
+}
+
+void RsubSse2(float *a, const float *b, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(a + i, _mm_sub_ps(_mm_loadu_ps(b + i), _mm_loadu_ps(a + i)));
+  }
+  RsubScalar(a + i, b + i, n - i);
+}
+
+void ScaleSse2(float *a, float num, std::size_t n) {
+  const __m128 factor = _mm_set1_ps(num);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(a + i, _mm_mul_ps(_mm_loadu_ps(a + i), factor));
+  }
+  ScaleScalar(a + i, num, n - i);
+}
+
+bool NearSse2(const float *a, const float *b, std::size_t n,
+              float tolerance) {
+  const __m128 sign = _mm_set1_ps(-0.0f);
+  const __m128 tol = _mm_set1_ps(tolerance);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 diff = _mm_sub_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i));
+    __m128 over = _mm_cmpgt_ps(_mm_andnot_ps(sign, diff), tol);
+    if (_mm_movemask_ps(over)) return false;
+  }
+  return NearScalar(a + i, b + i, n - i, tolerance);
+}
+
+void TransposeSse2(int rows, int cols, const float *src, std::ptrdiff_t lds,
+                   float *dst, std::ptrdiff_t ldd) {
+  const int rows4 = rows & ~3;
+  const int cols4 = cols & ~3;
+  for (int i = 0; i < rows4; i += 4) {
+    for (int j = 0; j < cols4; j += 4) {
+      const float *s = src + i * lds + j;
+      __m128 r0 = _mm_loadu_ps(s);
+      __m128 r1 = _mm_loadu_ps(s + lds);
+      __m128 r2 = _mm_loadu_ps(s + 2 * lds);
+      __m128 r3 = _mm_loadu_ps(s + 3 * lds);
+      _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+      float *d = dst + j * ldd + i;
+      _mm_storeu_ps(d, r0);
+      _mm_storeu_ps(d + ldd, r1);
+      _mm_storeu_ps(d + 2 * ldd, r2);
+      _mm_storeu_ps(d + 3 * ldd, r3);
+    }
+  }
+  TransposeEdges(rows, cols, rows4, cols4, src, lds, dst, ldd);
+}
+
+__attribute__((target("avx2"))) void AddAvx2(float *a, const float *b,
+                                             std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(a + i, _mm256_add_ps(_mm256_loadu_ps(a + i),
+                                          _mm256_loadu_ps(b + i)));
+  }
+  AddScalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("avx2"))) void SubAvx2(float *a, const float *b,
+                                             std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(a + i, _mm256_sub_ps(_mm256_loadu_ps(a + i),
+                                          _mm256_loadu_ps(b + i)));
+  }
+  SubScalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("avx2"))) void RsubAvx2(float *a, const float *b,
+                                              std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(a + i, _mm256_sub_ps(_mm256_loadu_ps(b + i),
+                                          _mm256_loadu_ps(a + i)));
+  }
+  RsubScalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("avx2"))) void ScaleAvx2(float *a, float num,
+                                               std::size_t n) {
+  const __m256 factor = _mm256_set1_ps(num);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(a + i, _mm256_mul_ps(_mm256_loadu_ps(a + i), factor));
+  }
+  ScaleScalar(a + i, num, n - i);
+}
+
+__attribute__((target("avx2"))) bool NearAvx2(const float *a, const float *b,
+                                              std::size_t n, float tolerance) {
+  const __m256 sign = _mm256_set1_ps(-0.0f);
+  const __m256 tol = _mm256_set1_ps(tolerance);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 diff = _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+    __m256 over = _mm256_cmp_ps(_mm256_andnot_ps(sign, diff), tol, _CMP_GT_OQ);
+    if (_mm256_movemask_ps(over)) return false;
+  }
+  return NearScalar(a + i, b + i, n - i, tolerance);
+}
+
+// 8x8 tile: interleave row pairs, then quadruples within each 128-bit lane,
+// then swap lane halves.
+__attribute__((target("avx2"))) void TransposeAvx2(int rows, int cols,
+                                                   const float *src,
+                                                   std::ptrdiff_t lds,
+                                                   float *dst,
+                                                   std::ptrdiff_t ldd) {
+  const int rows8 = rows & ~7;
+  const int cols8 = cols & ~7;
+  for (int i = 0; i < rows8; i += 8) {
+    for (int j = 0; j < cols8; j += 8) {
+      const float *s = src + i * lds + j;
+      __m256 t[8], u[8];
+      for (int r = 0; r < 8; r += 2) {
+        __m256 r0 = _mm256_loadu_ps(s + r * lds);
+        __m256 r1 = _mm256_loadu_ps(s + (r + 1) * lds);
+        t[r] = _mm256_unpacklo_ps(r0, r1);
+        t[r + 1] = _mm256_unpackhi_ps(r0, r1);
+      }
+      for (int r = 0; r < 8; r += 4) {
+        u[r] = _mm256_shuffle_ps(t[r], t[r + 2], _MM_SHUFFLE(1, 0, 1, 0));
+        u[r + 1] = _mm256_shuffle_ps(t[r], t[r + 2], _MM_SHUFFLE(3, 2, 3, 2));
+        u[r + 2] =
+            _mm256_shuffle_ps(t[r + 1], t[r + 3], _MM_SHUFFLE(1, 0, 1, 0));
+        u[r + 3] =
+            _mm256_shuffle_ps(t[r + 1], t[r + 3], _MM_SHUFFLE(3, 2, 3, 2));
+      }
+      float *d = dst + j * ldd + i;
+      for (int c = 0; c < 4; c++) {
+        _mm256_storeu_ps(d + c * ldd,
+                         _mm256_permute2f128_ps(u[c], u[c + 4], 0x20));
+        _mm256_storeu_ps(d + (c + 4) * ldd,
+                         _mm256_permute2f128_ps(u[c], u[c + 4], 0x31));
+      }
+    }
+  }
+  TransposeEdges(rows, cols, rows8, cols8, src, lds, dst, ldd);
+}
+
+__attribute__((target("avx512f"))) void AddAvx512(float *a, const float *b,
+                                                  std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    _mm512_storeu_ps(a + i, _mm512_add_ps(_mm512_loadu_ps(a + i),
+                                          _mm512_loadu_ps(b + i)));
+  }
+  AddScalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("avx512f"))) void SubAvx512(float *a, const float *b,
+                                                  std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    _mm512_storeu_ps(a + i, _mm512_sub_ps(_mm512_loadu_ps(a + i),
+                                          _mm512_loadu_ps(b + i)));
+  }
+  SubScalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("avx512f"))) void RsubAvx512(float *a, const float *b,
+                                                   std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    _mm512_storeu_ps(a + i, _mm512_sub_ps(_mm512_loadu_ps(b + i),
+                                          _mm512_loadu_ps(a + i)));
+  }
+  RsubScalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("avx512f"))) void ScaleAvx512(float *a, float num,
+                                                    std::size_t n) {
+  const __m512 factor = _mm512_set1_ps(num);
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    _mm512_storeu_ps(a + i, _mm512_mul_ps(_mm512_loadu_ps(a + i), factor));
+  }
+  ScaleScalar(a + i, num, n - i);
+}
+
+__attribute__((target("avx512f"))) bool NearAvx512(const float *a,
+                                                   const float *b,
+                                                   std::size_t n,
+                                                   float tolerance) {
+  const __m512 tol = _mm512_set1_ps(tolerance);
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m512 diff = _mm512_sub_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i));
+    if (_mm512_cmp_ps_mask(_mm512_abs_ps(diff), tol, _CMP_GT_OQ)) {
+      return false;
+    }
+  }
+  return NearScalar(a + i, b + i, n - i, tolerance);
+}
+
+#endif  // S21_SIMD_X86
+
+// The AVX-512 tables reuse the AVX2 transposes: a 4x4 tile of doubles or an
+// 8x8 tile of floats already fills whole cache lines on both sides.
+const ElementwiseKernels<double> kScalar = {
+    SimdLevel::kScalar,  AddScalar<double>,  SubScalar<double>,
+    RsubScalar<double>,  ScaleScalar<double>, NearScalar<double>,
+    TransposeScalar<double>};
+const ElementwiseKernels<float> kScalarFloat = {
+    SimdLevel::kScalar, AddScalar<float>,  SubScalar<float>,
+    RsubScalar<float>,  ScaleScalar<float>, NearScalar<float>,
+    TransposeScalar<float>};
+const ElementwiseKernels<long double> kScalarLongDouble = {
+    SimdLevel::kScalar,       AddScalar<long double>,
+    SubScalar<long double>,   RsubScalar<long double>,
+    ScaleScalar<long double>, NearScalar<long double>,
+    TransposeScalar<long double>};
+#ifdef S21_SIMD_X86
+const ElementwiseKernels<double> kSse2 = {
+    SimdLevel::kSse2, AddSse2,  SubSse2,      RsubSse2,
+    ScaleSse2,        NearSse2, TransposeSse2};
+const ElementwiseKernels<double> kAvx2 = {
+    SimdLevel::kAvx2, AddAvx2,  SubAvx2,      RsubAvx2,
+    ScaleAvx2,        NearAvx2, TransposeAvx2};
+const ElementwiseKernels<double> kAvx512 = {
+    SimdLevel::kAvx512, AddAvx512,  SubAvx512,    RsubAvx512,
+    ScaleAvx512,        NearAvx512, TransposeAvx2};
+const ElementwiseKernels<float> kSse2Float = {
+    SimdLevel::kSse2, AddSse2,  SubSse2,      RsubSse2,
+    ScaleSse2,        NearSse2, TransposeSse2};
+const ElementwiseKernels<float> kAvx2Float = {
+    SimdLevel::kAvx2, AddAvx2,  SubAvx2,      RsubAvx2,
+    ScaleAvx2,        NearAvx2, TransposeAvx2};
+const ElementwiseKernels<float> kAvx512Float = {
+    SimdLevel::kAvx512, AddAvx512,  SubAvx512,    RsubAvx512,
+    ScaleAvx512,        NearAvx512, TransposeAvx2};
+#endif
+
+SimdLevel DetectLevel() {
+  SimdLevel level = SimdLevel::kScalar;
+#ifdef S21_SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    level = SimdLevel::kAvx512;
+  } else if (__builtin_cpu_supports("avx2")) {
+    level = SimdLevel::kAvx2;
+  } else if (__builtin_cpu_supports("sse2")) {
+    level = SimdLevel::kSse2;
+  }
+#endif
+  return level;
+}
+
+SimdLevel SupportedLevel() {
+  static const SimdLevel supported = DetectLevel();
+  return supported;
+}
+
+const ElementwiseKernels<double> &TableFor(SimdLevel level, double) {
+#ifdef S21_SIMD_X86
+  if (level == SimdLevel::kAvx512) return kAvx512;
+  if (level == SimdLevel::kAvx2) return kAvx2;
+  if (level == SimdLevel::kSse2) return kSse2;
+#endif
+  return kScalar;
+}
+
+const ElementwiseKernels<float> &TableFor(SimdLevel level, float) {
+#ifdef S21_SIMD_X86
+  if (level == SimdLevel::kAvx512) return kAvx512Float;
+  if (level == SimdLevel::kAvx2) return kAvx2Float;
+  if (level == SimdLevel::kSse2) return kSse2Float;
+#endif
+  return kScalarFloat;
+}
+
+const ElementwiseKernels<long double> &TableFor(SimdLevel, long double) {
+  return kScalarLongDouble;
+}
+
+}  // namespace
+
+template <typename T>
+const ElementwiseKernels<T> &KernelsFor(SimdLevel level) {
+  return TableFor(std::min(level, SupportedLevel()), T());
+}
+
+template <typename T>
+const ElementwiseKernels<T> &Kernels() {
+  static const ElementwiseKernels<T> &active =
+      KernelsFor<T>(SimdLevel::kAvx512);
+  return active;
+}
+
+template const ElementwiseKernels<float> &KernelsFor(SimdLevel level);
+template const ElementwiseKernels<double> &KernelsFor(SimdLevel level);
+template const ElementwiseKernels<long double> &KernelsFor(SimdLevel level);
+template const ElementwiseKernels<float> &Kernels();
+template const ElementwiseKernels<double> &Kernels();
+template const ElementwiseKernels<long double> &Kernels();
+
+}  // namespace s21
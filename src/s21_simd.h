@@ -0,0 +1,40 @@
+#ifndef SRC_S21_SIMD_H_
+#define SRC_S21_SIMD_H_
+
+#include <cstddef>
+
+namespace s21 {
+
+enum class SimdLevel { kScalar, kSse2, kAvx2, kAvx512 };
+
+/*
+ * Element-wise and tile kernels over contiguous elements of type T. One
+ * implementation per instruction set is compiled in for float and double;
+ * the widest one the CPU supports is picked through CPUID on first use and
+ * kept for the life of the process. long double has no vector instructions
+ * and only gets the scalar table.
+ */
+template <typename T>
+struct ElementwiseKernels {
+  SimdLevel level;
+  void (*add)(T *a, const T *b, std::size_t n);
+  void (*sub)(T *a, const T *b, std::size_t n);
+  // a[i] = b[i] - a[i]
+  void (*rsub)(T *a, const T *b, std::size_t n);
+  void (*scale)(T *a, T num, std::size_t n);
+  // True when no |a[i] - b[i]| exceeds tolerance.
+  bool (*near)(const T *a, const T *b, std::size_t n, T tolerance);
+  // dst[j * ldd + i] = src[i * lds + j] for a rows x cols tile, moved through
+  // registers in square blocks.
+  void (*transpose)(int rows, int cols, const T *src, std::ptrdiff_t lds,
+                    T *dst, std::ptrdiff_t ldd);
+};
+
+template <typename T>
+const ElementwiseKernels<T> &Kernels();
+template <typename T>
+const ElementwiseKernels<T> &KernelsFor(SimdLevel level);
+
+}  // namespace s21
+
+#endif  // SRC_S21_SIMD_H_
@@ -0,0 +1,484 @@
+#include "s21_sparse_matrix.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_thread_pool.h"
+
+namespace {
+
+// Below this many multiply-adds waking the thread pool costs more than it
+// saves.
+constexpr long kParallelWork = 1 << 16;
+constexpr double kTolerance = 1e-7;
+
+struct CompressedRef {
+  const int *offsets;
+  const int *indices;
+  const double *values;
+};
+
+int ChunkCount(int count, long work) {
+  const int threads = s21::ThreadPool::Instance().ThreadCount();
+  if (threads < 2 || work < kParallelWork) return std::min(count, 1);
+  return std::min(count, 4 * threads);
+}
+
+// Splits [0, count) into chunks contiguous ranges and runs
+// body(chunk, begin, end) for each of them on the thread pool.
+void ForChunks(int count, int chunks,
+               const std::function<void(int, int, int)> &body) {
+  if (chunks == 1) {
+    body(0, 0, count);
+    return;
+  }
+  s21::ThreadPool::Instance().ParallelFor(chunks, [&](int chunk) {
+    body(chunk, int(long(count) * chunk / chunks),
+         int(long(count) * (chunk + 1) / chunks));
+  });
+}
+
+// Sorts every slice by index, sums duplicates, drops zeros and closes the
+// gaps this leaves.
+void Canonicalize(std::vector<int> &offsets, std::vector<int> &indices,
+                  std::vector<double> &values) {
+  std::vector<std::pair<int, double>> slice;
+  int out = 0;
+  for (std::size_t s = 0; s + 1 < offsets.size(); s++) {
+    slice.clear();
+    for (int p = offsets[s]; p < offsets[s + 1]; p++) {
+      slice.emplace_back(indices[p], values[p]);
+    }
+    std::stable_sort(
+        slice.begin(), slice.end(),
+        [](const std::pair<int, double> &a, const std::pair<int, double> &b) {
+          return a.first < b.first;
+        });
+    offsets[s] = out;
+    for (std::size_t q = 0; q < slice.size();) {
+      const int index = slice[q].first;
+      double sum = 0;
+      for (; q < slice.size() && slice[q].first == index; q++) {
+        sum += slice[q].second;
+      }
+      if (sum != 0) {
+        indices[out] = index;
+        values[out++] = sum;
+      }
+    }
+  }
+  offsets.back() = out;
+  indices.resize(out);
+  values.resize(out);
+}
+
+// Z = X * Y for matrices compressed along their rows, X having major slices.
+void Gustavson(int major, int minor, CompressedRef x, CompressedRef y,
+               std::vector<int> *z_offsets, std::vector<int> *z_indices,
+               std::vector<double> *z_values) {
+  long work = 0;
+  for (int p = 0; p < x.offsets[major]; p++) {
+    const int k = x.indices[p];
+    work += y.offsets[k + 1] - y.offsets[k];
+  }
+  const int chunks = ChunkCount(major, work);
+  std::vector<std::vector<int>> part_indices(chunks);
+  std::vector<std::vector<double>> part_values(chunks);
+  z_offsets->assign(major + 1, 0);
+  ForChunks(major, chunks, [&](int chunk, int begin, int end) {
+    std::vector<double> acc(minor);
+    std::vector<int> mark(minor, -1);
+    std::vector<int> touched;
+    std::vector<int> &indices = part_indices[chunk];
+    std::vector<double> &values = part_values[chunk];
+    for (int i = begin; i < end; i++) {
+      touched.clear();
+      for (int p = x.offsets[i]; p < x.offsets[i + 1]; p++) {
+        const int k = x.indices[p];
+        const double v = x.values[p];
+        for (int q = y.offsets[k]; q < y.offsets[k + 1]; q++) {
+          const int j = y.indices[q];
+          if (mark[j] != i) {
+            mark[j] = i;
+            acc[j] = 0;
+            touched.push_back(j);
+          }
+          acc[j] += v * y.values[q];
+        }
+      }
+      std::sort(touched.begin(), touched.end());
+      const std::size_t before = indices.size();
+      for (int j : touched) {
+        if (acc[j] != 0) {
+          indices.push_back(j);
+          values.push_back(acc[j]);
+        }
+      }
+      (*z_offsets)[i + 1] = int(indices.size() - before);
+    }
+  });
+  for (int i = 0; i < major; i++) (*z_offsets)[i + 1] += (*z_offsets)[i];
+  z_indices->clear();
+  z_values->clear();
+  z_indices->reserve(z_offsets->back());
+  z_values->reserve(z_offsets->back());
+  for (int chunk = 0; chunk < chunks; chunk++) {
+    z_indices->insert(z_indices->end(), part_indices[chunk].begin(),
+                      part_indices[chunk].end());
+    z_values->insert(z_values->end(), part_values[chunk].begin(),
+                     part_values[chunk].end());
+  }
+}
+
+// other itself when it is stored in format, else its conversion in storage.
+const S21SparseMatrix &InFormat(const S21SparseMatrix &other,
+                                S21SparseFormat format,
+                                S21SparseMatrix *storage) {
+  if (other.GetFormat() == format) return other;
+  *storage = other.ToFormat(format);
+  return *storage;
+}
+
+}  // namespace
+
+/** CONSTRUCTORS **/
+S21SparseMatrix::S21SparseMatrix()
+    : rows_(0), cols_(0), format_(S21SparseFormat::kCsr), offsets_(1, 0) {}
+
+S21SparseMatrix::S21SparseMatrix(int rows, int cols, S21SparseFormat format)
+    : rows_(rows), cols_(cols), format_(format) {
+  if (rows_ < 1 || cols_ < 1) {
+    throw std::out_of_range("Incorrect matrix size");
+  }
+  offsets_.assign(major() + 1, 0);
+}
+
+S21SparseMatrix::S21SparseMatrix(int rows, int cols,
+                                 const std::vector<S21Triplet> &entries,
+                                 S21SparseFormat format)
+    : S21SparseMatrix(rows, cols, format) {
+  const bool csr = format_ == S21SparseFormat::kCsr;
+  for (const S21Triplet &entry : entries) {
+    if (entry.row < 0 || entry.row >= rows_ || entry.col < 0 ||
+        entry.col >= cols_) {
+      throw std::out_of_range("Incorrect Index");
+    }
+    offsets_[(csr ? entry.row : entry.col) + 1]++;
+  }
+  for (int s = 0; s < major(); s++) offsets_[s + 1] += offsets_[s];
+  indices_.resize(entries.size());
+  values_.resize(entries.size());
+  std::vector<int> next(offsets_.begin(), offsets_.end() - 1);
+  for (const S21Triplet &entry : entries) {
+    const int p = next[csr ? entry.row : entry.col]++;
+    indices_[p] = csr ? entry.col : entry.row;
+    values_[p] = entry.value;
+  }
+  Canonicalize(offsets_, indices_, values_);
+}
+
+S21SparseMatrix::S21SparseMatrix(const S21Matrix &dense, double drop_tolerance,
+                                 S21SparseFormat format)
+    : S21SparseMatrix(dense.rows_, dense.cols_) {
+  for (int i = 0; i < rows_; i++) {
+    const double *row = dense.row(i);
+    for (int j = 0; j < cols_; j++) {
+      // Written so that NaN is kept rather than turned into a zero.
+      if (row[j] != 0 && !(std::fabs(row[j]) <= drop_tolerance)) {
+        indices_.push_back(j);
+        values_.push_back(row[j]);
+      }
+    }
+    offsets_[i + 1] = int(values_.size());
+  }
+  if (format != format_) *this = ToFormat(format);
+}
+
+/** CONVERSIONS **/
+S21SparseMatrix S21SparseMatrix::ToFormat(S21SparseFormat format) const {
+  if (format == format_ || rows_ == 0) {
+    S21SparseMatrix result(*this);
+    result.format_ = format;
+    if (rows_ == 0) result.offsets_.assign(1, 0);
+    return result;
+  }
+  // Walking the slices in order leaves every target slice sorted.
+  S21SparseMatrix result(rows_, cols_, format);
+  for (int index : indices_) result.offsets_[index + 1]++;
+  for (int s = 0; s < minor(); s++) {
+    result.offsets_[s + 1] += result.offsets_[s];
+  }
+  result.indices_.resize(indices_.size());
+  result.values_.resize(values_.size());
+  std::vector<int> next(result.offsets_.begin(), result.offsets_.end() - 1);
+  for (int s = 0; s < major(); s++) {
+    for (int p = offsets_[s]; p < offsets_[s + 1]; p++) {
+      const int q = next[indices_[p]]++;
+      result.indices_[q] = s;
+      result.values_[q] = values_[p];
+    }
+  }
+  return result;
+}
+
+S21Matrix S21SparseMatrix::ToDense() const {
+  S21Matrix result(rows_, cols_);
+  const bool csr = format_ == S21SparseFormat::kCsr;
+  for (int s = 0; s < major(); s++) {
+    for (int p = offsets_[s]; p < offsets_[s + 1]; p++) {
+      if (csr) {
+        result.row(s)[indices_[p]] = values_[p];
+      } else {
+        result.row(indices_[p])[s] = values_[p];
+      }
+    }
+  }
+  return result;
+}
+
+/** METHODS **/
+bool S21SparseMatrix::EqMatrix(const S21SparseMatrix &other) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_) return false;
+  S21SparseMatrix converted;
+  const S21SparseMatrix &same = InFormat(other, format_, &converted);
+  for (int s = 0; s < major(); s++) {
+    int p = offsets_[s], q = same.offsets_[s];
+    while (p < offsets_[s + 1] || q < same.offsets_[s + 1]) {
+      const int i = p < offsets_[s + 1] ? indices_[p] : minor();
+      const int j = q < same.offsets_[s + 1] ? same.indices_[q] : minor();
+      const double a = i <= j ? values_[p++] : 0;
+      const double b = j <= i ? same.values_[q++] : 0;
+      if (std::fabs(a - b) > kTolerance) return false;
+    }
+  }
+  return true;
+}
+
+void S21SparseMatrix::SumMatrix(const S21SparseMatrix &other) {
+  add_scaled(other, 1);
+}
+
+void S21SparseMatrix::SubMatrix(const S21SparseMatrix &other) {
+  add_scaled(other, -1);
+}
+
+void S21SparseMatrix::MulNumber(const double num) {
+  if (num == 0) {
+    std::fill(offsets_.begin(), offsets_.end(), 0);
+    indices_.clear();
+    values_.clear();
+    return;
+  }
+  for (double &value : values_) value *= num;
+}
+
+void S21SparseMatrix::MulMatrix(const S21SparseMatrix &other) {
+  if (cols_ != other.rows_) {
+    throw std::out_of_range("rows and cols aren't equal");
+  }
+  S21SparseMatrix converted;
+  const S21SparseMatrix &same = InFormat(other, format_, &converted);
+  CompressedRef lhs{offsets_.data(), indices_.data(), values_.data()};
+  CompressedRef rhs{same.offsets_.data(), same.indices_.data(),
+                    same.values_.data()};
+  std::vector<int> offsets, indices;
+  std::vector<double> values;
+  // A CSC matrix is the CSR storage of its transpose, and (AB)^T = B^T A^T.
+  if (format_ == S21SparseFormat::kCsr) {
+    Gustavson(rows_, same.cols_, lhs, rhs, &offsets, &indices, &values);
+  } else {
+    Gustavson(same.cols_, rows_, rhs, lhs, &offsets, &indices, &values);
+  }
+  cols_ = same.cols_;
+  offsets_.swap(offsets);
+  indices_.swap(indices);
+  values_.swap(values);
+}
+
+std::vector<double> S21SparseMatrix::MulVector(
+    const std::vector<double> &x) const {
+  if (std::size_t(cols_) != x.size()) {
+    throw std::out_of_range("rows and cols aren't equal");
+  }
+  std::vector<double> y(rows_);
+  if (format_ == S21SparseFormat::kCsc) {
+    for (int j = 0; j < cols_; j++) {
+      for (int p = offsets_[j]; p < offsets_[j + 1]; p++) {
+        y[indices_[p]] += values_[p] * x[j];
+      }
+    }
+    return y;
+  }
+  ForChunks(rows_, ChunkCount(rows_, GetNonZeros()), [&](int, int begin,
+                                                         int end) {
+    for (int i = begin; i < end; i++) {
+      double sum = 0;
+      for (int p = offsets_[i]; p < offsets_[i + 1]; p++) {
+        sum += values_[p] * x[indices_[p]];
+      }
+      y[i] = sum;
+    }
+  });
+  return y;
+}
+
+S21Matrix S21SparseMatrix::MulDense(const S21Matrix &other) const {
+  if (cols_ != other.rows_) {
+    throw std::out_of_range("rows and cols aren't equal");
+  }
+  if (format_ == S21SparseFormat::kCsc) {
+    return ToFormat(S21SparseFormat::kCsr).MulDense(other);
+  }
+  S21Matrix result(rows_, other.cols_);
+  const int n = other.cols_;
+  ForChunks(rows_, ChunkCount(rows_, long(GetNonZeros()) * n),
+            [&](int, int begin, int end) {
+              for (int i = begin; i < end; i++) {
+                double *out = result.row(i);
+                for (int p = offsets_[i]; p < offsets_[i + 1]; p++) {
+                  const double v = values_[p];
+                  const double *in = other.row(indices_[p]);
+                  for (int j = 0; j < n; j++) out[j] += v * in[j];
+                }
+              }
+            });
+  return result;
+}
+
+S21Matrix S21SparseMatrix::left_mul(const S21Matrix &lhs) const {
+  if (lhs.cols_ != rows_) {
+    throw std::out_of_range("rows and cols aren't equal");
+  }
+  if (format_ == S21SparseFormat::kCsc) {
+    return ToFormat(S21SparseFormat::kCsr).left_mul(lhs);
+  }
+  S21Matrix result(lhs.rows_, cols_);
+  ForChunks(lhs.rows_, ChunkCount(lhs.rows_, long(GetNonZeros()) * lhs.rows_),
+            [&](int, int begin, int end) {
+              for (int i = begin; i < end; i++) {
+                const double *in = lhs.row(i);
+                double *out = result.row(i);
+                for (int k = 0; k < rows_; k++) {
+                  if (in[k] == 0) continue;
+                  for (int p = offsets_[k]; p < offsets_[k + 1]; p++) {
+                    out[indices_[p]] += in[k] * values_[p];
+                  }
+                }
+              }
+            });
+  return result;
+}
+
+/** OVERLOAD OPERATORS **/
+S21SparseMatrix S21SparseMatrix::operator+(
+    const S21SparseMatrix &other) const {
+  S21SparseMatrix result(*this);
+  result.SumMatrix(other);
+  return result;
+}
+
+S21SparseMatrix S21SparseMatrix::operator-(
+    const S21SparseMatrix &other) const {
+  S21SparseMatrix result(*this);
+  result.SubMatrix(other);
+  return result;
+}
+
+S21SparseMatrix S21SparseMatrix::operator*(
+    const S21SparseMatrix &other) const {
+  S21SparseMatrix result(*this);
+  result.MulMatrix(other);
+  return result;
+}
+
+S21SparseMatrix S21SparseMatrix::operator*(const double &num) const {
+  S21SparseMatrix result(*this);
+  result.MulNumber(num);
+  return result;
+}
+
+S21Matrix S21SparseMatrix::operator*(const S21Matrix &other) const {
+  return MulDense(other);
+}
+
+std::vector<double> S21SparseMatrix::operator*(
+    const std::vector<double> &x) const {
+  return MulVector(x);
+}
+
+bool S21SparseMatrix::operator==(const S21SparseMatrix &other) const {
+  return EqMatrix(other);
+}
+
+S21SparseMatrix &S21SparseMatrix::operator+=(const S21SparseMatrix &other) {
+  SumMatrix(other);
+  return *this;
+}
+
+S21SparseMatrix &S21SparseMatrix::operator-=(const S21SparseMatrix &other) {
+  SubMatrix(other);
+  return *this;
+}
+
+S21SparseMatrix &S21SparseMatrix::operator*=(const S21SparseMatrix &other) {
+  MulMatrix(other);
+  return *this;
+}
+
+S21SparseMatrix &S21SparseMatrix::operator*=(const double &num) {
+  MulNumber(num);
+  return *this;
+}
+
+double S21SparseMatrix::operator()(const int row, const int col) const {
+  if (rows_ <= row || cols_ <= col || row < 0 || col < 0) {
+    throw std::out_of_range("Incorrect Index");
+  }
+  const bool csr = format_ == S21SparseFormat::kCsr;
+  const int s = csr ? row : col;
+  const int index = csr ? col : row;
+  const int *begin = indices_.data() + offsets_[s];
+  const int *end = indices_.data() + offsets_[s + 1];
+  const int *found = std::lower_bound(begin, end, index);
+  if (found == end || *found != index) return 0;
+  return values_[found - indices_.data()];
+}
+
+S21Matrix operator*(const S21Matrix &lhs, const S21SparseMatrix &rhs) {
+  return rhs.left_mul(lhs);
+}
+
+/** HELP FUNCTIONS **/
+// this += sign * other, merging the sorted slices.
+void S21SparseMatrix::add_scaled(const S21SparseMatrix &other, double sign) {
+  if (rows_ != other.rows_ || cols_ != other.cols_) {
+    throw std::out_of_range(
+        "Incorrect input, matrices should have the same size");
+  }
+  S21SparseMatrix converted;
+  const S21SparseMatrix &same = InFormat(other, format_, &converted);
+  std::vector<int> offsets(major() + 1, 0), indices;
+  std::vector<double> values;
+  indices.reserve(indices_.size() + same.indices_.size());
+  values.reserve(indices.capacity());
+  for (int s = 0; s < major(); s++) {
+    int p = offsets_[s], q = same.offsets_[s];
+    while (p < offsets_[s + 1] || q < same.offsets_[s + 1]) {
+      const int i = p < offsets_[s + 1] ? indices_[p] : minor();
+      const int j = q < same.offsets_[s + 1] ? same.indices_[q] : minor();
+      const double a = i <= j ? values_[p++] : 0;
+      const double b = j <= i ? sign * same.values_[q++] : 0;
+      if (a + b != 0) {
+        indices.push_back(std::min(i, j));
+        values.push_back(a + b);
+      }
+    }
+    offsets[s + 1] = int(values.size());
+  }
+  offsets_.swap(offsets);
+  indices_.swap(indices);
+  values_.swap(values);
+}
@@ -0,0 +1,85 @@
+#ifndef SRC_S21_SPARSE_MATRIX_H_
+#define SRC_S21_SPARSE_MATRIX_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+enum class S21SparseFormat { kCsr, kCsc };
+
+struct S21Triplet {
+  int row, col;
+  double value;
+};
+
+/*
+ * Compressed sparse matrix. In kCsr format the nonzeros of row i are
+ * values_[offsets_[i] .. offsets_[i + 1]) with their column numbers in
+ * indices_; kCsc stores columns the same way. Indices within a row (column)
+ * are kept sorted and unique, and exact zeros are never stored, so memory
+ * and the cost of every operation scale with the number of nonzeros.
+ * Binary operations on operands of different formats convert the right one.
+ */
+class S21SparseMatrix {
+  friend S21Matrix operator*(const S21Matrix &lhs, const S21SparseMatrix &rhs);
+
+ public:
+  S21SparseMatrix();
+  S21SparseMatrix(int rows, int cols,
+                  S21SparseFormat format = S21SparseFormat::kCsr);
+  // Entries at the same position are summed.
+  S21SparseMatrix(int rows, int cols, const std::vector<S21Triplet> &entries,
+                  S21SparseFormat format = S21SparseFormat::kCsr);
+  // Entries with |value| <= drop_tolerance are left out; NaN is kept.
+  explicit S21SparseMatrix(const S21Matrix &dense, double drop_tolerance = 0,
+                           S21SparseFormat format = S21SparseFormat::kCsr);
+
+  int GetRows() const { return rows_; }
+  int GetCols() const { return cols_; }
+  int GetNonZeros() const { return int(values_.size()); }
+  S21SparseFormat GetFormat() const { return format_; }
+
+  S21SparseMatrix ToFormat(S21SparseFormat format) const;
+  S21Matrix ToDense() const;
+
+  bool EqMatrix(const S21SparseMatrix &other) const;
+  void SumMatrix(const S21SparseMatrix &other);
+  void SubMatrix(const S21SparseMatrix &other);
+  void MulNumber(const double num);
+  // Sparse times sparse, row by row with a dense accumulator (Gustavson),
+  // rows split across the thread pool.
+  void MulMatrix(const S21SparseMatrix &other);
+  // Sparse times dense vector and dense matrix.
+  std::vector<double> MulVector(const std::vector<double> &x) const;
+  S21Matrix MulDense(const S21Matrix &other) const;
+
+  S21SparseMatrix operator+(const S21SparseMatrix &other) const;
+  S21SparseMatrix operator-(const S21SparseMatrix &other) const;
+  S21SparseMatrix operator*(const S21SparseMatrix &other) const;
+  S21SparseMatrix operator*(const double &num) const;
+  S21Matrix operator*(const S21Matrix &other) const;
+  std::vector<double> operator*(const std::vector<double> &x) const;
+  bool operator==(const S21SparseMatrix &other) const;
+  S21SparseMatrix &operator+=(const S21SparseMatrix &other);
+  S21SparseMatrix &operator-=(const S21SparseMatrix &other);
+  S21SparseMatrix &operator*=(const S21SparseMatrix &other);
+  S21SparseMatrix &operator*=(const double &num);
+  // Zero for positions that are not stored.
+  double operator()(const int row, const int col) const;
+
+ private:
+  int rows_, cols_;
+  S21SparseFormat format_;
+  std::vector<int> offsets_;
+  std::vector<int> indices_;
+  std::vector<double> values_;
+
+  int major() const { return format_ == S21SparseFormat::kCsr ? rows_ : cols_; }
+  int minor() const { return format_ == S21SparseFormat::kCsr ? cols_ : rows_; }
+  void add_scaled(const S21SparseMatrix &other, double sign);
+  S21Matrix left_mul(const S21Matrix &lhs) const;
+};
+
+S21Matrix operator*(const S21Matrix &lhs, const S21SparseMatrix &rhs);
+
+#endif  // SRC_S21_SPARSE_MATRIX_H_
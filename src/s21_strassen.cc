@@ -0,0 +1,182 @@
+#include "s21_strassen.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include "s21_gemm.h"
+
+namespace s21 {
+
+namespace {
+
+std::atomic<int> strassen_cutoff{512};
+
+// Sizes TuneStrassenCutoff tries, smallest first.
+constexpr int kTuneSizes[] = {128, 256, 512, 1024, 2048};
+
+template <typename T>
+struct Block {
+  T *data;
+  std::ptrdiff_t ld;
+  T *at(int i, int j) const { return data + i * ld + j; }
+};
+
+template <typename T>
+struct ConstBlock {
+  const T *data;
+  std::ptrdiff_t ld;
+  ConstBlock(const T *d, std::ptrdiff_t l) : data(d), ld(l) {}
+  ConstBlock(const Block<T> &block)  // NOLINT
+      : data(block.data), ld(block.ld) {}
+  const T *at(int i, int j) const { return data + i * ld + j; }
+};
+
+template <typename T>
+void Add(int rows, int cols, ConstBlock<T> x, ConstBlock<T> y,
+         Block<T> out) {
+  for (int i = 0; i < rows; i++) {
+    const T *xi = x.at(i, 0);
+    const T *yi = y.at(i, 0);
+    T *oi = out.at(i, 0);
+    for (int j = 0; j < cols; j++) oi[j] = xi[j] + yi[j];
+  }
+}
+
+template <typename T>
+void Sub(int rows, int cols, ConstBlock<T> x, ConstBlock<T> y,
+         Block<T> out) {
+  for (int i = 0; i < rows; i++) {
+    const T *xi = x.at(i, 0);
+    const T *yi = y.at(i, 0);
+    T *oi = out.at(i, 0);
+    for (int j = 0; j < cols; j++) oi[j] = xi[j] - yi[j];
+  }
+}
+
+template <typename T>
+void Recurse(int m, int n, int k, ConstBlock<T> a, ConstBlock<T> b,
+             Block<T> c, int cutoff);
+
+// One level on even m, n, k, following the two-temporary schedule of
+// Boyer, Dumas, Pernet and Zhou (ISSAC 2009).
+template <typename T>
+void Level(int m, int n, int k, ConstBlock<T> a, ConstBlock<T> b, Block<T> c,
+           int cutoff) {
+  const int mh = m / 2, nh = n / 2, kh = k / 2;
+  ConstBlock<T> a11(a.at(0, 0), a.ld), a12(a.at(0, kh), a.ld);
+  ConstBlock<T> a21(a.at(mh, 0), a.ld), a22(a.at(mh, kh), a.ld);
+  ConstBlock<T> b11(b.at(0, 0), b.ld), b12(b.at(0, nh), b.ld);
+  ConstBlock<T> b21(b.at(kh, 0), b.ld), b22(b.at(kh, nh), b.ld);
+  Block<T> c11{c.at(0, 0), c.ld}, c12{c.at(0, nh), c.ld};
+  Block<T> c21{c.at(mh, 0), c.ld}, c22{c.at(mh, nh), c.ld};
+  const int x_cols = std::max(kh, nh);
+  std::vector<T> x_buffer(std::size_t(mh) * x_cols);
+  std::vector<T> y_buffer(std::size_t(kh) * nh);
+  Block<T> x{x_buffer.data(), x_cols};
+  Block<T> y{y_buffer.data(), nh};
+
+  Sub<T>(mh, kh, a11, a21, x);                    // S3
+  Sub<T>(kh, nh, b22, b12, y);                    // T3
+  Recurse<T>(mh, nh, kh, x, y, c21, cutoff);      // P7
+  Add<T>(mh, kh, a21, a22, x);                    // S1
+  Sub<T>(kh, nh, b12, b11, y);                    // T1
+  Recurse<T>(mh, nh, kh, x, y, c22, cutoff);      // P5
+  Sub<T>(mh, kh, x, a11, x);                      // S2
+  Sub<T>(kh, nh, b22, y, y);                      // T2
+  Recurse<T>(mh, nh, kh, x, y, c12, cutoff);      // P6
+  Sub<T>(mh, kh, a12, x, x);                      // S4
+  Recurse<T>(mh, nh, kh, x, b22, c11, cutoff);    // P3
+  Recurse<T>(mh, nh, kh, a11, b11, x, cutoff);    // P1
+  Add<T>(mh, nh, x, c12, c12);                    // U2 = P1 + P6
+  Add<T>(mh, nh, c12, c21, c21);                  // U3 = U2 + P7
+  Add<T>(mh, nh, c12, c22, c12);                  // U4 = U2 + P5
+  Add<T>(mh, nh, c21, c22, c22);                  // U7 = U3 + P5
+  Add<T>(mh, nh, c12, c11, c12);                  // U5 = U4 + P3
+  Sub<T>(kh, nh, y, b21, y);                      // T4
+  Recurse<T>(mh, nh, kh, a22, y, c11, cutoff);    // P4
+  Sub<T>(mh, nh, c21, c11, c21);                  // U6 = U3 - P4
+  Recurse<T>(mh, nh, kh, a12, b21, c11, cutoff);  // P2
+  Add<T>(mh, nh, x, c11, c11);                    // U1 = P1 + P2
+}
+
+template <typename T>
+void Recurse(int m, int n, int k, ConstBlock<T> a, ConstBlock<T> b,
+             Block<T> c, int cutoff) {
+  if (m <= cutoff || n <= cutoff || k <= cutoff) {
+    Gemm(m, n, k, T(1), a.data, a.ld, 1, b.data, b.ld, 1, T(0), c.data, c.ld);
+    return;
+  }
+  const int me = m & ~1, ne = n & ~1, ke = k & ~1;
+  Level(me, ne, ke, a, b, c, cutoff);
+  if (ke != k) {
+    Gemm(me, ne, 1, T(1), a.at(0, ke), a.ld, 1, b.at(ke, 0), b.ld, 1, T(1),
+         c.data, c.ld);
+  }
+  if (ne != n) {
+    Gemm(me, 1, k, T(1), a.data, a.ld, 1, b.at(0, ne), b.ld, 1, T(0),
+         c.at(0, ne), c.ld);
+  }
+  if (me != m) {
+    Gemm(1, n, k, T(1), a.at(me, 0), a.ld, 1, b.data, b.ld, 1, T(0),
+         c.at(me, 0), c.ld);
+  }
+}
+
+double Seconds(int m, int n, int k, int cutoff, const std::vector<double> &a,
+               const std::vector<double> &b, std::vector<double> *c) {
+  const auto start = std::chrono::steady_clock::now();
+  Recurse(m, n, k, ConstBlock<double>(a.data(), k),
+          ConstBlock<double>(b.data(), n), Block<double>{c->data(), n},
+          cutoff);
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+      .count();
+}
+
+}  // namespace
+
+template <typename T>
+void StrassenGemm(int m, int n, int k, const T *a, std::ptrdiff_t lda,
+                  const T *b, std::ptrdiff_t ldb, T *c, std::ptrdiff_t ldc) {
+  if (m <= 0 || n <= 0) return;
+  Recurse(m, n, k, ConstBlock<T>(a, lda), ConstBlock<T>(b, ldb),
+          Block<T>{c, ldc}, std::max(GetStrassenCutoff(), 1));
+}
+
+template void StrassenGemm(int m, int n, int k, const float *a,
+                           std::ptrdiff_t lda, const float *b,
+                           std::ptrdiff_t ldb, float *c, std::ptrdiff_t ldc);
+template void StrassenGemm(int m, int n, int k, const double *a,
+                           std::ptrdiff_t lda, const double *b,
+                           std::ptrdiff_t ldb, double *c, std::ptrdiff_t ldc);
+template void StrassenGemm(int m, int n, int k, const long double *a,
+                           std::ptrdiff_t lda, const long double *b,
+                           std::ptrdiff_t ldb, long double *c,
+                           std::ptrdiff_t ldc);
+
+int GetStrassenCutoff() { return strassen_cutoff; }
+
+void SetStrassenCutoff(int cutoff) { strassen_cutoff = std::max(cutoff, 1); }
+
+int TuneStrassenCutoff() {
+  int cutoff = kTuneSizes[std::size(kTuneSizes) - 1];
+  for (int n : kTuneSizes) {
+    std::vector<double> a(std::size_t(n) * n), b(a.size()), c(a.size());
+    for (std::size_t i = 0; i < a.size(); i++) {
+      a[i] = double(i % 7) - 3;
+      b[i] = double(i % 5) - 2;
+    }
+    const double classic = Seconds(n, n, n, n, a, b, &c);
+    const double strassen = Seconds(n, n, n, n / 2, a, b, &c);
+    if (strassen < classic) {
+      cutoff = n / 2;
+      break;
+    }
+  }
+  SetStrassenCutoff(cutoff);
+  return cutoff;
+}
+
+}  // namespace s21
@@ -0,0 +1,39 @@
+#ifndef SRC_S21_STRASSEN_H_
+#define SRC_S21_STRASSEN_H_
+
+#include <cstddef>
+
+namespace s21 {
+
+/*
+ * C = A * B for a row-major m x k operand A and k x n operand B by the
+ * Strassen-Winograd recursion: 7 half-size products and 15 additions per
+ * level, scheduled with two temporaries. Recursion stops once any dimension
+ * is at most the cutoff and the blocked Gemm takes over. Odd dimensions are
+ * peeled: the even part recurses and the last row, column or rank-1 term is
+ * finished by Gemm.
+ *
+ * Unlike the classic product, whose error is bounded per element by
+ * |C - fl(C)| <= k u |A| |B| + O(u^2), the bound only holds in norm and
+ * grows with the recursion depth:
+ *   ||C - fl(C)|| <= ((n / n0)^log2(18) (n0^2 + 5 n0) - 5 n) u ||A|| ||B||
+ * for n x n operands, cutoff n0 and unit roundoff u (Higham, "Accuracy and
+ * Stability of Numerical Algorithms", 23.2). Elements much smaller than the
+ * norms may lose all relative accuracy. Instantiated for float, double and
+ * long double; the cutoff is shared and tuned on double.
+ */
+template <typename T>
+void StrassenGemm(int m, int n, int k, const T *a, std::ptrdiff_t lda,
+                  const T *b, std::ptrdiff_t ldb, T *c, std::ptrdiff_t ldc);
+
+int GetStrassenCutoff();
+void SetStrassenCutoff(int cutoff);
+
+// Times one recursion level against the classic kernel on this machine,
+// stores the smallest size at which it pays off as the cutoff and returns
+// it. Takes a few seconds.
+int TuneStrassenCutoff();
+
+}  // namespace s21
+
+#endif  // SRC_S21_STRASSEN_H_
@@ -0,0 +1,245 @@
+#include "s21_symmetric_matrix.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_thread_pool.h"
+
+namespace {
+
+// Rows whose off-diagonal block is computed in one parallel step.
+constexpr int kRowBlock = 64;
+
+double Dot(const double *x, const double *y, int count) {
+  double sum = 0;
+  for (int k = 0; k < count; k++) sum += x[k] * y[k];
+  return sum;
+}
+
+std::size_t RowStart(int row) { return std::size_t(row) * (row + 1) / 2; }
+
+}  // namespace
+
+/** CONSTRUCTORS **/
+S21SymmetricMatrix::S21SymmetricMatrix() : size_(0) {}
+
+S21SymmetricMatrix::S21SymmetricMatrix(int size) : size_(size) {
+  if (size_ < 1) {
+    throw std::out_of_range("Incorrect matrix size");
+  }
+  values_.assign(RowStart(size_), 0);
+}
+
+S21SymmetricMatrix::S21SymmetricMatrix(const S21Matrix &dense)
+    : S21SymmetricMatrix(dense.rows_) {
+  if (!dense.IsSymmetric()) {
+    throw std::out_of_range("Matrix must be symmetric");
+  }
+  for (int i = 0; i < size_; i++) {
+    std::copy_n(dense.row(i), i + 1, values_.data() + RowStart(i));
+  }
+}
+
+/** CONVERSIONS **/
+S21Matrix S21SymmetricMatrix::ToDense() const {
+  S21Matrix dense(size_, size_);
+  for (int i = 0; i < size_; i++) {
+    const double *packed = values_.data() + RowStart(i);
+    double *row = dense.row(i);
+    for (int j = 0; j <= i; j++) {
+      row[j] = packed[j];
+      dense.row(j)[i] = packed[j];
+    }
+  }
+  return dense;
+}
+
+/** METHODS **/
+bool S21SymmetricMatrix::EqMatrix(const S21SymmetricMatrix &other) const {
+  if (size_ != other.size_) return false;
+  for (std::size_t p = 0; p < values_.size(); p++) {
+    if (std::fabs(values_[p] - other.values_[p]) > s21::kEqTolerance<double>) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void S21SymmetricMatrix::SumMatrix(const S21SymmetricMatrix &other) {
+  if (size_ != other.size_) {
+    throw std::out_of_range(
+        "Incorrect input, matrices should have the same size");
+  }
+  for (std::size_t p = 0; p < values_.size(); p++) {
+    values_[p] += other.values_[p];
+  }
+}
+
+void S21SymmetricMatrix::SubMatrix(const S21SymmetricMatrix &other) {
+  if (size_ != other.size_) {
+    throw std::out_of_range(
+        "Incorrect input, matrices should have the same size");
+  }
+  for (std::size_t p = 0; p < values_.size(); p++) {
+    values_[p] -= other.values_[p];
+  }
+}
+
+void S21SymmetricMatrix::MulNumber(const double num) {
+  for (double &value : values_) value *= num;
+}
+
+double S21SymmetricMatrix::Determinant() const {
+  std::vector<double> factor;
+  if (!cholesky(factor)) return ToDense().Determinant(S21Factorization::kLU);
+  double determ = 1;
+  for (int i = 0; i < size_; i++) determ *= factor[RowStart(i) + i];
+  return determ * determ;
+}
+
+/*
+ * inv(A) = inv(L)^T * inv(L). inv(L) is built in place, row i from the rows
+ * above it; then row k of it adds its outer product with itself, restricted
+ * to the lower triangle, to the result.
+ */
+S21SymmetricMatrix S21SymmetricMatrix::InverseMatrix() const {
+  std::vector<double> factor;
+  if (!cholesky(factor)) {
+    return average(ToDense().InverseMatrix(S21Factorization::kLU));
+  }
+  std::vector<double> work(size_);
+  for (int i = 0; i < size_; i++) {
+    double *ri = factor.data() + RowStart(i);
+    std::fill(work.begin(), work.begin() + i, 0.0);
+    for (int k = 0; k < i; k++) {
+      const double *rk = factor.data() + RowStart(k);
+      for (int j = 0; j <= k; j++) work[j] += ri[k] * rk[j];
+    }
+    const double inverse = 1 / ri[i];
+    for (int j = 0; j < i; j++) ri[j] = -work[j] * inverse;
+    ri[i] = inverse;
+  }
+  S21SymmetricMatrix result(size_);
+  for (int k = 0; k < size_; k++) {
+    const double *rk = factor.data() + RowStart(k);
+    for (int i = 0; i <= k; i++) {
+      double *out = result.values_.data() + RowStart(i);
+      for (int j = 0; j <= i; j++) out[j] += rk[i] * rk[j];
+    }
+  }
+  return result;
+}
+
+// L * y = other row by row, then L^T * x = y by scattering each solved row
+// upwards; every step is an update of a whole row of other.
+S21Matrix S21SymmetricMatrix::Solve(const S21Matrix &other) const {
+  if (size_ != other.rows_) {
+    throw std::out_of_range("rows and cols aren't equal");
+  }
+  std::vector<double> factor;
+  if (!cholesky(factor)) {
+    return ToDense().Solve(other, S21Factorization::kLU);
+  }
+  S21Matrix result(other);
+  const int cols = result.cols_;
+  for (int i = 0; i < size_; i++) {
+    const double *ri = factor.data() + RowStart(i);
+    double *xi = result.row(i);
+    for (int k = 0; k < i; k++) {
+      const double *xk = result.row(k);
+      for (int j = 0; j < cols; j++) xi[j] -= ri[k] * xk[j];
+    }
+    for (int j = 0; j < cols; j++) xi[j] /= ri[i];
+  }
+  for (int i = size_ - 1; i >= 0; i--) {
+    const double *ri = factor.data() + RowStart(i);
+    double *xi = result.row(i);
+    for (int j = 0; j < cols; j++) xi[j] /= ri[i];
+    for (int k = 0; k < i; k++) {
+      double *xk = result.row(k);
+      for (int j = 0; j < cols; j++) xk[j] -= ri[k] * xi[j];
+    }
+  }
+  return result;
+}
+
+/** OVERLOAD OPERATORS **/
+double &S21SymmetricMatrix::operator()(const int row, const int col) {
+  return values_[index(row, col)];
+}
+
+const double &S21SymmetricMatrix::operator()(const int row,
+                                             const int col) const {
+  return values_[index(row, col)];
+}
+
+/** HELP FUNCTIONS **/
+std::size_t S21SymmetricMatrix::index(int row, int col) const {
+  if (size_ <= row || size_ <= col || row < 0 || col < 0) {
+    throw std::out_of_range("Incorrect Index");
+  }
+  if (row < col) std::swap(row, col);
+  return RowStart(row) + col;
+}
+
+// Packs (A + A^T) / 2 without checking symmetry first: an LU inverse is
+// only symmetric up to rounding, which can exceed the IsSymmetric tolerance.
+S21SymmetricMatrix S21SymmetricMatrix::average(const S21Matrix &dense) {
+  S21SymmetricMatrix result(dense.rows_);
+  for (int i = 0; i < result.size_; i++) {
+    double *packed = result.values_.data() + RowStart(i);
+    const double *row = dense.row(i);
+    for (int j = 0; j <= i; j++) packed[j] = (row[j] + dense.row(j)[i]) / 2;
+  }
+  return result;
+}
+
+/*
+ * Packed Cholesky factor L, row by row, each element one dot product of two
+ * contiguous packed rows. Blocks of kRowBlock rows first take every column
+ * left of the block in parallel, as those only need finished rows, and then
+ * finish the triangle inside the block in order. Returns false as soon as a
+ * pivot is not above n * eps * max_j |a_ij| for its row, the test the dense
+ * class uses for singularity, so that such matrices take the LU path.
+ */
+bool S21SymmetricMatrix::cholesky(std::vector<double> &factor) const {
+  std::vector<double> tolerance(size_, 0);
+  for (int i = 0; i < size_; i++) {
+    const double *ri = values_.data() + RowStart(i);
+    for (int j = 0; j <= i; j++) {
+      tolerance[i] = std::max(tolerance[i], std::fabs(ri[j]));
+      tolerance[j] = std::max(tolerance[j], std::fabs(ri[j]));
+    }
+  }
+  for (double &value : tolerance) {
+    value *= size_ * std::numeric_limits<double>::epsilon();
+  }
+  factor = values_;
+  double *l = factor.data();
+  for (int i0 = 0; i0 < size_; i0 += kRowBlock) {
+    const int i1 = std::min(i0 + kRowBlock, size_);
+    if (i0 > 0) {
+      s21::ThreadPool::Instance().ParallelFor(i1 - i0, [&](int block_row) {
+        double *ri = l + RowStart(i0 + block_row);
+        for (int j = 0; j < i0; j++) {
+          const double *rj = l + RowStart(j);
+          ri[j] = (ri[j] - Dot(ri, rj, j)) / rj[j];
+        }
+      });
+    }
+    for (int i = i0; i < i1; i++) {
+      double *ri = l + RowStart(i);
+      for (int j = i0; j < i; j++) {
+        const double *rj = l + RowStart(j);
+        ri[j] = (ri[j] - Dot(ri, rj, j)) / rj[j];
+      }
+      const double d = ri[i] - Dot(ri, ri, i);
+      if (!(d > tolerance[i])) return false;
+      ri[i] = std::sqrt(d);
+    }
+  }
+  return true;
+}
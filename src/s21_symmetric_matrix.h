@@ -0,0 +1,50 @@
+#ifndef SRC_S21_SYMMETRIC_MATRIX_H_
+#define SRC_S21_SYMMETRIC_MATRIX_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+/*
+ * Symmetric matrix stored as its packed lower triangle: row i holds elements
+ * (i, 0) .. (i, i) and starts at values_[i * (i + 1) / 2], so a matrix of
+ * order n takes n * (n + 1) / 2 doubles instead of n * n. Determinant,
+ * InverseMatrix and Solve factor it by Cholesky in the packed layout and
+ * fall back to the dense LU path when it is not positive definite, which
+ * includes a pivot of rounding size; that path decides singularity.
+ */
+class S21SymmetricMatrix {
+ public:
+  S21SymmetricMatrix();
+  explicit S21SymmetricMatrix(int size);
+  // Keeps the lower triangle; throws unless dense.IsSymmetric().
+  explicit S21SymmetricMatrix(const S21Matrix &dense);
+
+  int GetRows() const { return size_; }
+  int GetCols() const { return size_; }
+  S21Matrix ToDense() const;
+
+  bool EqMatrix(const S21SymmetricMatrix &other) const;
+  void SumMatrix(const S21SymmetricMatrix &other);
+  void SubMatrix(const S21SymmetricMatrix &other);
+  void MulNumber(const double num);
+  double Determinant() const;
+  S21SymmetricMatrix InverseMatrix() const;
+  // Returns X with this * X = other.
+  S21Matrix Solve(const S21Matrix &other) const;
+
+  // (row, col) and (col, row) are the same element.
+  double &operator()(const int row, const int col);
+  const double &operator()(const int row, const int col) const;
+
+ private:
+  int size_;
+  std::vector<double> values_;
+
+  std::size_t index(int row, int col) const;
+  static S21SymmetricMatrix average(const S21Matrix &dense);
+  bool cholesky(std::vector<double> &factor) const;
+};
+
+#endif  // SRC_S21_SYMMETRIC_MATRIX_H_
@@ -0,0 +1,167 @@
+#include "s21_thread_pool.h"
+
+#include <cstdlib>
+
+namespace s21 {
+
+namespace {
+
+thread_local bool inside_pool = false;
+
+// Marks the current thread as running pool tasks, also if one throws.
+class PoolScope {
+ public:
+  PoolScope() : outer_(inside_pool) { inside_pool = true; }
+  PoolScope(const PoolScope &) = delete;
+  PoolScope &operator=(const PoolScope &) = delete;
+  ~PoolScope() { inside_pool = outer_; }
+
+ private:
+  bool outer_;
+};
+
+}  // namespace
+
+ThreadPool &ThreadPool::Instance() {
+  static ThreadPool pool;
+  return pool;
+}
+
+ThreadPool::~ThreadPool() { Stop(); }
+
+int ThreadPool::DefaultThreadCount() {
+  const char *env = std::getenv("S21_NUM_THREADS");
+  if (env != nullptr) {
+    int count = std::atoi(env);
+    if (count > 0) return count;
+  }
+  int count = static_cast<int>(std::thread::hardware_concurrency());
+  return count > 0 ? count : 1;
+}
+
+int ThreadPool::ThreadCount() {
+  // The submitting thread holds submit_mutex_ while it runs tasks.
+  if (inside_pool) return 1;
+  std::lock_guard<std::mutex> lock(submit_mutex_);
+  if (thread_count_ == 0) thread_count_ = DefaultThreadCount();
+  return thread_count_;
+}
+
+void ThreadPool::SetThreadCount(int count) {
+  std::lock_guard<std::mutex> lock(submit_mutex_);
+  Stop();
+  thread_count_ = count > 0 ? count : DefaultThreadCount();
+}
+
+void ThreadPool::ParallelFor(int count,
+                             const std::function<void(int)> &task) {
+  if (count <= 0) return;
+  if (inside_pool || count == 1) {
+    for (int i = 0; i < count; i++) task(i);
+    return;
+  }
+  std::lock_guard<std::mutex> submit(submit_mutex_);
+  if (thread_count_ == 0) thread_count_ = DefaultThreadCount();
+  if (thread_count_ == 1) {
+    PoolScope scope;
+    for (int i = 0; i < count; i++) task(i);
+    return;
+  }
+  if (!started_) Start();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    task_ = &task;
+    task_count_ = count;
+    next_task_ = 0;
+    finished_tasks_ = 0;
+    failed_ = false;
+    error_ = nullptr;
+    generation_++;
+  }
+  wake_.notify_all();
+  {
+    PoolScope scope;
+    FinishTasks(RunTasks(task, count), false);
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_.wait(lock, [this] {
+    return finished_tasks_ == task_count_ && active_workers_ == 0;
+  });
+  task_ = nullptr;
+  if (error_) {
+    std::exception_ptr error = error_;
+    error_ = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+void ThreadPool::Start() {
+  stopping_ = false;
+  for (int i = 1; i < thread_count_; i++) {
+    workers_.emplace_back(&ThreadPool::WorkerLoop, this);
+  }
+  started_ = true;
+}
+
+void ThreadPool::Stop() {
+  if (!started_) return;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  for (std::thread &worker : workers_) worker.join();
+  workers_.clear();
+  started_ = false;
+}
+
+void ThreadPool::WorkerLoop() {
+  inside_pool = true;
+  unsigned long seen = 0;
+  for (;;) {
+    const std::function<void(int)> *task = nullptr;
+    int count = 0;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      wake_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+      if (stopping_) return;
+      seen = generation_;
+      task = task_;
+      count = task_count_;
+      active_workers_++;
+    }
+    FinishTasks(task == nullptr ? 0 : RunTasks(*task, count), true);
+  }
+}
+
+// Claims task indices until none are left. Returns how many were claimed
+// here; after a failure they are still claimed, but no longer run, so that
+// the count the submitter waits for is reached. The first exception is kept
+// for ParallelFor to rethrow, since one escaping a worker would terminate.
+int ThreadPool::RunTasks(const std::function<void(int)> &task, int count) {
+  int done = 0;
+  for (int i = next_task_++; i < count; i = next_task_++) {
+    if (!failed_) {
+      try {
+        task(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!error_) error_ = std::current_exception();
+        failed_ = true;
+      }
+    }
+    done++;
+  }
+  return done;
+}
+
+void ThreadPool::FinishTasks(int done, bool worker) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  finished_tasks_ += done;
+  if (worker) active_workers_--;
+  if (finished_tasks_ == task_count_ && active_workers_ == 0) {
+    done_.notify_all();
+  }
+}
+
+}  // namespace s21
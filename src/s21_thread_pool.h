@@ -0,0 +1,68 @@
+#ifndef SRC_S21_THREAD_POOL_H_
+#define SRC_S21_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace s21 {
+
+/*
+ * Process-wide pool of worker threads shared by the parallel kernels. The
+ * workers are started on the first parallel call. The thread count defaults
+ * to the S21_NUM_THREADS environment variable, or to the hardware
+ * concurrency when it is unset, and counts the calling thread.
+ */
+class ThreadPool {
+ public:
+  static ThreadPool &Instance();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+  ~ThreadPool();
+
+  // Inside a task this is 1, matching how nested ParallelFor calls run.
+  int ThreadCount();
+  // A count below 1 restores the default.
+  void SetThreadCount(int count);
+
+  // Runs task(0) .. task(count - 1) on the workers and the calling thread and
+  // returns when all of them have finished. Calls made from inside a task run
+  // serially on the current thread. Once a task throws, tasks not yet started
+  // are skipped and the first exception is rethrown here.
+  void ParallelFor(int count, const std::function<void(int)> &task);
+
+ private:
+  ThreadPool() = default;
+  static int DefaultThreadCount();
+  void Start();
+  void Stop();
+  void WorkerLoop();
+  int RunTasks(const std::function<void(int)> &task, int count);
+  void FinishTasks(int done, bool worker);
+
+  std::mutex submit_mutex_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  std::vector<std::thread> workers_;
+  int thread_count_ = 0;
+  bool started_ = false;
+  bool stopping_ = false;
+  unsigned long generation_ = 0;
+  const std::function<void(int)> *task_ = nullptr;
+  int task_count_ = 0;
+  std::atomic<int> next_task_{0};
+  int finished_tasks_ = 0;
+  int active_workers_ = 0;
+  std::atomic<bool> failed_{false};
+  std::exception_ptr error_;
+};
+
+}  // namespace s21
+
+#endif  // SRC_S21_THREAD_POOL_H_
@@ -0,0 +1,95 @@
+#include "s21_transpose.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "s21_simd.h"
+
+namespace s21 {
+
+namespace {
+
+// A 32 x 32 tile of doubles is 8 KB, a quarter of a typical L1. Splits are
+// rounded to multiples of 8, the widest register tile of any element type.
+constexpr int kTile = 32;
+
+template <typename T>
+void TransposeRecursive(const ElementwiseKernels<T> &kernels, int rows,
+                        int cols, const T *src, std::ptrdiff_t lds, T *dst,
+                        std::ptrdiff_t ldd) {
+  if (rows <= kTile && cols <= kTile) {
+    kernels.transpose(rows, cols, src, lds, dst, ldd);
+  } else if (rows >= cols) {
+    const int half = rows / 2 & ~7;
+    TransposeRecursive(kernels, half, cols, src, lds, dst, ldd);
+    TransposeRecursive(kernels, rows - half, cols, src + half * lds, lds,
+                       dst + half, ldd);
+  } else {
+    const int half = cols / 2 & ~7;
+    TransposeRecursive(kernels, rows, half, src, lds, dst, ldd);
+    TransposeRecursive(kernels, rows, cols - half, src + half, lds,
+                       dst + half * ldd, ldd);
+  }
+}
+
+}  // namespace
+
+template <typename T>
+void Transpose(int rows, int cols, const T *src, std::ptrdiff_t lds, T *dst,
+               std::ptrdiff_t ldd) {
+  if (rows <= 0 || cols <= 0) return;
+  TransposeRecursive(Kernels<T>(), rows, cols, src, lds, dst, ldd);
+}
+
+template <typename T>
+void TransposeSquareInPlace(int n, T *a, std::ptrdiff_t ld) {
+  const ElementwiseKernels<T> &kernels = Kernels<T>();
+  T tmp[kTile * kTile];
+  for (int bi = 0; bi < n; bi += kTile) {
+    const int h = std::min(kTile, n - bi);
+    for (int bj = bi; bj < n; bj += kTile) {
+      const int w = std::min(kTile, n - bj);
+      T *x = a + bi * ld + bj;
+      T *y = a + bj * ld + bi;
+      kernels.transpose(h, w, x, ld, tmp, h);
+      if (bi != bj) kernels.transpose(w, h, y, ld, x, ld);
+      for (int i = 0; i < w; i++) std::copy_n(tmp + i * h, h, y + i * ld);
+    }
+  }
+}
+
+template <typename T>
+void TransposeDenseInPlace(int rows, int cols, T *a) {
+  if (rows <= 1 || cols <= 1) return;
+  // Element k = i * cols + j moves to j * rows + i, which is k * rows taken
+  // modulo size - 1; the first and the last element stay where they are.
+  const unsigned long long last = (unsigned long long)rows * cols - 1;
+  std::vector<bool> visited(last + 1);
+  for (unsigned long long start = 1; start < last; start++) {
+    if (visited[start]) continue;
+    T carried = a[start];
+    unsigned long long k = start;
+    do {
+      k = k * rows % last;
+      std::swap(carried, a[k]);
+      visited[k] = true;
+    } while (k != start);
+  }
+}
+
+template void Transpose(int rows, int cols, const float *src,
+                        std::ptrdiff_t lds, float *dst, std::ptrdiff_t ldd);
+template void Transpose(int rows, int cols, const double *src,
+                        std::ptrdiff_t lds, double *dst, std::ptrdiff_t ldd);
+template void Transpose(int rows, int cols, const long double *src,
+                        std::ptrdiff_t lds, long double *dst,
+                        std::ptrdiff_t ldd);
+template void TransposeSquareInPlace(int n, float *a, std::ptrdiff_t ld);
+template void TransposeSquareInPlace(int n, double *a, std::ptrdiff_t ld);
+template void TransposeSquareInPlace(int n, long double *a,
+                                     std::ptrdiff_t ld);
+template void TransposeDenseInPlace(int rows, int cols, float *a);
+template void TransposeDenseInPlace(int rows, int cols, double *a);
+template void TransposeDenseInPlace(int rows, int cols, long double *a);
+
+}  // namespace s21
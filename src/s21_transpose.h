@@ -0,0 +1,28 @@
+#ifndef SRC_S21_TRANSPOSE_H_
+#define SRC_S21_TRANSPOSE_H_
+
+#include <cstddef>
+
+namespace s21 {
+
+// dst (cols x rows, leading dimension ldd) = transpose of src (rows x cols).
+// Recursively halves the longer side until a tile fits in L1, so both the
+// reads and the writes stay cache and TLB friendly at any size. These are
+// instantiated for float, double and long double.
+template <typename T>
+void Transpose(int rows, int cols, const T *src, std::ptrdiff_t lds, T *dst,
+               std::ptrdiff_t ldd);
+
+// Transposes the n x n block at a in place, swapping mirrored tiles.
+template <typename T>
+void TransposeSquareInPlace(int n, T *a, std::ptrdiff_t ld);
+
+// Turns the dense rows x cols array at a (leading dimension cols) into the
+// dense cols x rows transpose in the same memory by following the cycles of
+// the index permutation. Needs one bit of scratch per element.
+template <typename T>
+void TransposeDenseInPlace(int rows, int cols, T *a);
+
+}  // namespace s21
+
+#endif  // SRC_S21_TRANSPOSE_H_